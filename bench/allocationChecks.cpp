@@ -0,0 +1,97 @@
+// File:  allocationChecks.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Heap allocation budgets for the ingestion path.  Each decode is run
+//        once to warm up (interning names, growing reused buffers) and then
+//        measured; exceeding a budget fails the benchmark run.
+
+// Local headers
+#include "benchmark.h"
+#include "payloads.h"
+#include "gitHubInterface.h"
+#include "assetTable.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+struct AllocationBudget
+{
+	const char* name;
+	double perRecord;
+	uint64_t fixed;// Allocations allowed regardless of record count
+};
+
+static uint64_t CountAllocations(const std::function<void()>& function)
+{
+	function();// Warm-up
+
+	const uint64_t start(AllocationCounter::count);
+	AllocationCounter::enabled = true;
+	function();
+	AllocationCounter::enabled = false;
+	return AllocationCounter::count - start;
+}
+
+static bool CheckBudget(const AllocationBudget& budget, const size_t& recordCount,
+	const std::function<void()>& function)
+{
+	const uint64_t count(CountAllocations(function));
+	const double limit(budget.perRecord * recordCount + budget.fixed);
+	const bool pass(count <= limit);
+
+	std::cout << std::left << std::setw(52) << budget.name << std::right << std::fixed
+		<< std::setw(10) << std::setprecision(3) << static_cast<double>(count) / recordCount << " allocs/record"
+		<< std::setw(10) << count << " / " << std::setprecision(0) << limit
+		<< (pass ? "  ok" : "  REGRESSION") << std::endl;
+
+	return pass;
+}
+
+bool RunAllocationChecks()
+{
+	PrintBenchmarkHeader("Ingestion allocation budgets");
+
+	const unsigned int count(1000);
+	const std::string repos(GenerateReposPayload(count));
+	const std::string releases(GenerateReleasesPayload(count));
+	bool pass(true);
+
+	// Records handed to a callback reuse their buffers
+	pass &= CheckBudget({ "DecodeRepos (callback)", 0.0, 16 }, count, [&repos]()
+	{
+		size_t decoded(0);
+		GitHubInterface::DecodeRepos(repos, [&decoded](GitHubInterface::RepoInfo&)
+		{
+			++decoded;
+		});
+		DoNotOptimize(decoded);
+	});
+
+	// Owned records:  description and releases URL, plus vector growth
+	pass &= CheckBudget({ "DecodeRepos (vector)", 2.0, 16 }, count, [&repos]()
+	{
+		std::vector<GitHubInterface::RepoInfo> decoded;
+		GitHubInterface::DecodeRepos(repos, decoded);
+		DoNotOptimize(decoded.data());
+	});
+
+	// One asset list per release, plus the (reserved) release vector
+	pass &= CheckBudget({ "DecodeReleases (vector)", 1.0, 1 }, count, [&releases]()
+	{
+		std::vector<GitHubInterface::ReleaseData> decoded;
+		GitHubInterface::DecodeReleases(releases, decoded);
+		DoNotOptimize(decoded.data());
+	});
+
+	AssetTable table;
+	pass &= CheckBudget({ "DecodeReleases (reused asset table)", 0.0, 0 }, count, [&releases, &table]()
+	{
+		table.Clear();
+		GitHubInterface::DecodeReleases(releases, 0, table);
+		DoNotOptimize(table.GetRowCount());
+	});
+
+	return pass;
+}
@@ -0,0 +1,20 @@
+// File:  benchMain.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Entry point for the benchmark suite (make bench).
+
+// Local headers
+#include "benchmark.h"
+
+int main(int, char*[])
+{
+	InstallCJSONAllocationHooks();
+
+	RunJSONBenchmarks();
+	RunTableBenchmarks();
+	const bool allocationsOK(RunAllocationChecks());
+	const bool inputOK(RunInputChecks());
+	const bool countOK(RunCountChecks());
+
+	return allocationsOK && inputOK && countOK ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+// File:  benchmark.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Minimal microbenchmark harness.  Each benchmark is calibrated to run
+//        for a fixed wall time and reports time, allocations and throughput
+//        per operation.
+
+// Local headers
+#include "benchmark.h"
+#include "cJSON.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <new>
+
+uint64_t AllocationCounter::count = 0;
+uint64_t AllocationCounter::bytes = 0;
+bool AllocationCounter::enabled = false;
+
+static void* CountedAllocate(const size_t& size)
+{
+	if (AllocationCounter::enabled)
+	{
+		++AllocationCounter::count;
+		AllocationCounter::bytes += size;
+	}
+	return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(size_t size)
+{
+	void* p(CountedAllocate(size));
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return CountedAllocate(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+static void* CJSONMalloc(size_t size)
+{
+	return CountedAllocate(size);
+}
+
+void InstallCJSONAllocationHooks()
+{
+	cJSON_Hooks hooks;
+	hooks.malloc_fn = CJSONMalloc;
+	hooks.free_fn = free;
+	cJSON_InitHooks(&hooks);
+}
+
+void BenchmarkState::PauseTiming()
+{
+	elapsed += Clock::now() - start;
+	allocationCount += AllocationCounter::count - countAtStart;
+	allocationBytes += AllocationCounter::bytes - bytesAtStart;
+}
+
+void BenchmarkState::ResumeTiming()
+{
+	countAtStart = AllocationCounter::count;
+	bytesAtStart = AllocationCounter::bytes;
+	start = Clock::now();
+}
+
+static void RunIterations(const BenchmarkFunction& function, BenchmarkState& state)
+{
+	AllocationCounter::enabled = true;
+	state.ResumeTiming();
+	function(state);
+	state.PauseTiming();
+	AllocationCounter::enabled = false;
+}
+
+BenchmarkResult RunBenchmark(const std::string& name, const size_t& payloadBytes,
+	const BenchmarkFunction& function)
+{
+	const double minimumCalibrationTime(0.05);// [sec]
+	const double targetTime(0.5);// [sec]
+
+	// Grow the iteration count until the run is long enough to scale from
+	size_t iterations(1);
+	double secondsPerOp;
+	while (true)
+	{
+		BenchmarkState calibration(iterations);
+		RunIterations(function, calibration);
+		secondsPerOp = calibration.GetElapsedSeconds() / iterations;
+		if (calibration.GetElapsedSeconds() >= minimumCalibrationTime || iterations >= (size_t(1) << 30))
+			break;
+		iterations *= 2;
+	}
+
+	if (secondsPerOp > 0.0)
+	{
+		const size_t scaled(static_cast<size_t>(targetTime / secondsPerOp));
+		if (scaled > iterations)
+			iterations = scaled;
+	}
+
+	BenchmarkState state(iterations);
+	RunIterations(function, state);
+	const double seconds(state.GetElapsedSeconds());
+
+	BenchmarkResult result;
+	result.nsPerOp = seconds * 1.0e9 / iterations;
+	result.bytesPerOp = static_cast<double>(state.GetAllocationBytes()) / iterations;
+	result.allocationsPerOp = static_cast<double>(state.GetAllocationCount()) / iterations;
+	result.mbPerSecond = seconds > 0.0 ? payloadBytes * static_cast<double>(iterations) / seconds / 1.0e6 : 0.0;
+
+	std::cout << std::left << std::setw(44) << name << std::right << std::fixed
+		<< std::setw(14) << std::setprecision(1) << result.nsPerOp << " ns/op"
+		<< std::setw(12) << std::setprecision(0) << result.bytesPerOp << " B/op"
+		<< std::setw(10) << std::setprecision(1) << result.allocationsPerOp << " allocs/op";
+	if (payloadBytes > 0)
+		std::cout << std::setw(10) << std::setprecision(1) << result.mbPerSecond << " MB/s";
+	std::cout << std::endl;
+
+	return result;
+}
+
+void PrintBenchmarkHeader(const std::string& title)
+{
+	std::cout << '\n' << title << '\n' << std::string(title.length(), '-') << std::endl;
+}
+
+bool Check(const std::string& name, const std::function<bool()>& function)
+{
+	const bool pass(function());
+	std::cout << std::left << std::setw(72) << name << (pass ? "ok" : "REGRESSION") << std::endl;
+	return pass;
+}
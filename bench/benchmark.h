@@ -0,0 +1,95 @@
+// File:  benchmark.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Minimal microbenchmark harness.  Each benchmark is calibrated to run
+//        for a fixed wall time and reports time, allocations and throughput
+//        per operation.
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+// Standard C++ headers
+#include <string>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+// Counts every allocation made through operator new and through the cJSON
+// hooks (see InstallCJSONAllocationHooks())
+struct AllocationCounter
+{
+	static uint64_t count;
+	static uint64_t bytes;
+	static bool enabled;
+};
+
+void InstallCJSONAllocationHooks();
+
+class BenchmarkState
+{
+public:
+	explicit BenchmarkState(const size_t& iterations) : iterations(iterations) {}
+
+	const size_t iterations;
+
+	// Excludes setup work (and its allocations) from the measurement
+	void PauseTiming();
+	void ResumeTiming();
+
+	double GetElapsedSeconds() const { return std::chrono::duration<double>(elapsed).count(); }
+	uint64_t GetAllocationCount() const { return allocationCount; }
+	uint64_t GetAllocationBytes() const { return allocationBytes; }
+
+private:
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start;
+	Clock::duration elapsed = Clock::duration::zero();
+	uint64_t allocationCount = 0;
+	uint64_t allocationBytes = 0;
+	uint64_t countAtStart = 0;
+	uint64_t bytesAtStart = 0;
+};
+
+struct BenchmarkResult
+{
+	double nsPerOp;
+	double bytesPerOp;
+	double allocationsPerOp;
+	double mbPerSecond;// Zero when no payload size was given
+};
+
+// The function must perform state.iterations operations
+typedef std::function<void(BenchmarkState&)> BenchmarkFunction;
+
+// Runs, prints and returns the result for a single benchmark.  payloadBytes is
+// the amount of input processed by each operation (for MB/s).
+BenchmarkResult RunBenchmark(const std::string& name, const size_t& payloadBytes,
+	const BenchmarkFunction& function);
+
+void PrintBenchmarkHeader(const std::string& title);
+
+// Runs and prints a correctness check; returns its result
+bool Check(const std::string& name, const std::function<bool()>& function);
+
+// Prevents the optimizer from discarding a result
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Suites
+void RunJSONBenchmarks();
+void RunTableBenchmarks();
+
+// Returns false if any allocation budget is exceeded
+bool RunAllocationChecks();
+
+// Returns false if any malformed input is mishandled
+bool RunInputChecks();
+
+// Returns false if the count store loses a change or a query disagrees with
+// the samples
+bool RunCountChecks();
+
+#endif// BENCHMARK_H_
@@ -0,0 +1,188 @@
+// File:  countChecks.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Regression checks for the download count store and the queries over
+//        it.  Each run records what --compare would, then checks what reads back.
+
+// Local headers
+#include "benchmark.h"
+#include "countStore.h"
+#include "countDelta.h"
+#include "countHistory.h"
+#include "countRollups.h"
+#include "countQuery.h"
+
+// Standard C++ headers
+#include <filesystem>
+#include <vector>
+#include <string>
+#include <tuple>
+
+// Records the observations that differ from the store, as RecordChanges() does
+static bool Record(const std::string& snapshotFileName, const std::string& logFileName,
+	const std::vector<CountSnapshot::Entry>& current)
+{
+	CountStore store;
+	if (!store.Open(snapshotFileName, logFileName))
+		return false;
+
+	std::vector<CountDelta::Delta> deltas;
+	CountDelta::Compute(store, current, deltas);
+
+	std::vector<CountSnapshot::Entry> changes;
+	for (size_t i = 0; i < current.size(); ++i)
+	{
+		if (CountDelta::IsChange(current[i], deltas[i]))
+			changes.push_back(current[i]);
+	}
+
+	return changes.empty() || store.Update(changes);
+}
+
+static uint64_t GetCountedTotal(const std::string& snapshotFileName, const std::string& logFileName)
+{
+	CountStore store;
+	bool overflow(false);
+	if (!store.Open(snapshotFileName, logFileName))
+		return 0;
+	return CountDelta::GetCountedTotal(store, "repo", overflow);
+}
+
+// The counted asset of a release moves to another asset while neither count
+// changes; only the new one may be counted afterwards
+static bool CountedAssetMoves(const bool& fold)
+{
+	const std::filesystem::path directory(std::filesystem::temp_directory_path());
+	const std::string snapshotFileName((directory / "gitHubStatsCheck.snapshot").string());
+	const std::string logFileName((directory / "gitHubStatsCheck.log").string());
+	std::error_code error;
+	std::filesystem::remove(snapshotFileName, error);
+	std::filesystem::remove(logFileName, error);
+
+	const std::vector<CountSnapshot::Entry> before({
+		{ "repo", "v1.0", "setup.exe", 10, CountSnapshot::Counted },
+		{ "repo", "v1.0", "source.zip", 5, 0 } });
+	const std::vector<CountSnapshot::Entry> after({
+		{ "repo", "v1.0", "setup.exe", 10, 0 },
+		{ "repo", "v1.0", "source.zip", 5, CountSnapshot::Counted } });
+
+	bool pass(Record(snapshotFileName, logFileName, before) &&
+		GetCountedTotal(snapshotFileName, logFileName) == 10 &&
+		Record(snapshotFileName, logFileName, after));
+
+	if (pass && fold)
+	{
+		CountStore store;
+		pass = store.Open(snapshotFileName, logFileName) && store.Fold();
+	}
+	pass = pass && GetCountedTotal(snapshotFileName, logFileName) == 5;
+
+	std::filesystem::remove(snapshotFileName, error);
+	std::filesystem::remove(logFileName, error);
+	return pass;
+}
+
+// Polls a few assets for 40 days, with the rollups starting after the history
+// does.  Every window must give the same answer with the rollups as when it's
+// replayed from the samples alone.
+static bool RollupsMatchReplay()
+{
+	const std::filesystem::path directory(std::filesystem::temp_directory_path() / "gitHubStatsQueryCheck");
+	std::error_code error;
+	std::filesystem::remove_all(directory, error);
+	if (!std::filesystem::create_directories(directory, error))
+		return false;
+
+	const std::string snapshotFileName((directory / "owner.snapshot").string());
+	const std::string logFileName((directory / "owner.log").string());
+	const std::string historyFileName((directory / "owner.history").string());
+	const std::string archiveFileName((directory / "owner.archive").string());
+	const std::string rollupFileName((directory / "owner.rollups").string());
+
+	// The second repo and the last asset appear part way through
+	const char* names[][3] = { { "a", "v1", "x" }, { "a", "v1", "y" }, { "b", "v1", "x" }, { "a", "v2", "x" } };
+	uint64_t downloads[] = { 10, 20, 30, 40 };
+	uint64_t seed(0x9E3779B97F4A7C15);
+	const auto next([&seed]()
+	{
+		seed = seed * 6364136223846793005 + 1442695040888963407;
+		return seed >> 16;
+	});
+
+	const int64_t start(1700000000 + 1234);
+	const int64_t rollupStart(start + 2 * 24 * 3600 + 999);
+	bool pass(true);
+	for (int64_t time = start; pass && time < start + 40 * 24 * 3600; time += 600 + next() % 5400)
+	{
+		const size_t assetCount(time < start + 3 * 24 * 3600 ? 2 : time < start + 6 * 24 * 3600 ? 3 : 4);
+		std::vector<CountSnapshot::Entry> current;
+		for (size_t i = 0; i < assetCount; ++i)
+		{
+			if (next() % 3 == 0)
+				downloads[i] += next() % 20;
+			current.push_back({ names[i][0], names[i][1], names[i][2], downloads[i], CountSnapshot::Counted });
+		}
+
+		CountStore store;
+		std::vector<CountDelta::Delta> deltas;
+		pass = store.Open(snapshotFileName, logFileName);
+		CountDelta::Compute(store, current, deltas);
+
+		std::vector<CountSnapshot::Entry> changes;
+		std::vector<CountHistory::Sample> samples;
+		for (size_t i = 0; i < current.size(); ++i)
+		{
+			if (!CountDelta::IsChange(current[i], deltas[i]))
+				continue;
+			changes.push_back(current[i]);
+			samples.push_back({ current[i].repo, current[i].tag, current[i].asset, current[i].count, current[i].flags });
+		}
+
+		if (changes.empty())
+			continue;
+
+		pass = pass && CountHistory::Append(historyFileName, time, samples) && store.Update(changes);
+
+		CountRollups rollups;
+		if (pass && time >= rollupStart)
+		{
+			pass = rollups.Load(rollupFileName);
+			rollups.Add(time, current, deltas);
+			pass = pass && rollups.Save(rollupFileName);
+		}
+	}
+
+	CountQuery fromRollups, replayed;
+	pass = pass && fromRollups.Load("owner", archiveFileName, historyFileName, rollupFileName) &&
+		replayed.Load("owner", archiveFileName, historyFileName, (directory / "missing.rollups").string());
+
+	std::vector<CountQuery::Result> a, b;
+	for (int i = 0; pass && i < 300; ++i)
+	{
+		const int64_t end(start + static_cast<int64_t>(next() % (42 * 24 * 3600)));
+		const int64_t begin(end - static_cast<int64_t>(1 + next() % 14) * 24 * 3600);
+		const CountRollups::Level level(static_cast<CountRollups::Level>(i % CountRollups::LevelCount));
+		fromRollups.Run(level, begin, end, a);
+		replayed.Run(level, begin, end, b);
+
+		pass = a.size() == b.size();
+		for (size_t j = 0; pass && j < a.size(); ++j)
+			pass = std::tie(a[j].repo, a[j].tag, a[j].asset, a[j].downloads, a[j].previousDownloads, a[j].firstSeen, a[j].lastChange) ==
+				std::tie(b[j].repo, b[j].tag, b[j].asset, b[j].downloads, b[j].previousDownloads, b[j].firstSeen, b[j].lastChange);
+	}
+
+	std::filesystem::remove_all(directory, error);
+	return pass;
+}
+
+bool RunCountChecks()
+{
+	PrintBenchmarkHeader("Count store");
+	bool pass(true);
+
+	pass &= Check("Counted flag moves with an unchanged count (logged)", []() { return CountedAssetMoves(false); });
+	pass &= Check("Counted flag moves with an unchanged count (folded)", []() { return CountedAssetMoves(true); });
+	pass &= Check("Query from rollups matches replaying the samples", RollupsMatchReplay);
+
+	return pass;
+}
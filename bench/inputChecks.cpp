@@ -0,0 +1,60 @@
+// File:  inputChecks.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Regression checks for malformed or edge-case input.  Each case that
+//        once misbehaved is run again; a wrong result fails the benchmark run.
+//        (Memory errors are only caught reliably in a sanitizer build.)
+
+// Local headers
+#include "benchmark.h"
+#include "cJSON.h"
+#include "timestamp.h"
+
+// Standard C++ headers
+#include <string>
+
+// True if cJSON rejects the text
+static bool Rejects(const char* text)
+{
+	cJSON* root(cJSON_Parse(text));
+	const bool rejected(!root);
+	cJSON_Delete(root);
+	return rejected;
+}
+
+bool RunInputChecks()
+{
+	PrintBenchmarkHeader("Malformed input");
+	bool pass(true);
+
+	pass &= Check("cJSON_Parse(NULL)", []() { return Rejects(nullptr); });
+
+	// A non-hex digit used to be skipped, desyncing the copy from the length
+	// pass and writing past the string
+	pass &= Check("cJSON \\u escape with a non-hex digit", []() { return Rejects("[\"\\\\ud83d\\ude0\\\\\"},12]"); });
+	pass &= Check("cJSON \\u surrogate with a non-hex digit", []() { return Rejects("[\"\\ud83d\\udeZ0\"]"); });
+	pass &= Check("cJSON valid surrogate pair", []()
+	{
+		cJSON* root(cJSON_Parse("[\"\\ud83d\\ude00\"]"));
+		const bool decoded(root && root->child && std::string(root->child->valuestring) == "\xF0\x9F\x98\x80");
+		cJSON_Delete(root);
+		return decoded;
+	});
+
+	pass &= Check("Timestamp 1970-01-01T00:00:00Z is set", []()
+	{
+		Timestamp t;
+		return Timestamp::Parse("1970-01-01T00:00:00Z", t) && t.IsSet() && t.GetSeconds() == 0 &&
+			t.ToString() == "1970-01-01T00:00:00Z" && !Timestamp().IsSet() && t != Timestamp();
+	});
+
+	pass &= Check("Timestamp February 29 only in leap years", []()
+	{
+		Timestamp t;
+		return Timestamp::Parse("2024-02-29T00:00:00Z", t) && Timestamp::Parse("2000-02-29T00:00:00Z", t) &&
+			!Timestamp::Parse("2023-02-29T00:00:00Z", t) && !Timestamp::Parse("1900-02-29T00:00:00Z", t) &&
+			!Timestamp::Parse("2024-02-30T00:00:00Z", t);
+	});
+
+	return pass;
+}
@@ -0,0 +1,254 @@
+// File:  jsonBenchmarks.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Benchmarks for each of the JSON decoding paths on repos and releases
+//        responses of varying size.
+
+// Local headers
+#include "benchmark.h"
+#include "payloads.h"
+#include "cJSON.h"
+#include "jsonInterface.h"
+#include "jsonTape.h"
+#include "jsonEventParser.h"
+#include "gitHubInterface.h"
+
+// Standard C++ headers
+#include <vector>
+
+// Exposes the ReadJSON() lookups
+class ReadJSONAccess : public JSONInterface
+{
+public:
+	using JSONInterface::ReadJSON;
+
+	// The legacy lookups only produce std::strings
+	template<typename Node>
+	static bool ReadJSON(const Node& root, const std::string& field, InternedString& value)
+	{
+		std::string s;
+		if (!JSONInterface::ReadJSON(root, field, s))
+			return false;
+		value = InternedString(s);
+		return true;
+	}
+
+	template<typename Node>
+	static bool ReadJSON(const Node& root, const std::string& field, Timestamp& value)
+	{
+		std::string s;
+		return JSONInterface::ReadJSON(root, field, s) && Timestamp::Parse(s, value);
+	}
+};
+
+static void ReadRepo(cJSON* node, GitHubInterface::RepoInfo& repo)
+{
+	ReadJSONAccess::ReadJSON(node, "name", repo.name);
+	ReadJSONAccess::ReadJSON(node, "description", repo.description);
+	ReadJSONAccess::ReadJSON(node, "updated_at", repo.lastUpdateTime);
+	ReadJSONAccess::ReadJSON(node, "created_at", repo.creationTime);
+	ReadJSONAccess::ReadJSON(node, "language", repo.language);
+	ReadJSONAccess::ReadJSON(node, "releases_url", repo.releasesURL);
+}
+
+// Equivalent of the original cJSON-based GetReleaseData()/GetAssetData()
+static void ReadRelease(cJSON* node, GitHubInterface::ReleaseData& release)
+{
+	ReadJSONAccess::ReadJSON(node, "tag_name", release.tag);
+	ReadJSONAccess::ReadJSON(node, "created_at", release.creationTime);
+
+	cJSON* assets(cJSON_GetObjectItem(node, "assets"));
+	if (!assets)
+		return;
+
+	const int count(cJSON_GetArraySize(assets));
+	for (int i = 0; i < count; ++i)
+	{
+		cJSON* assetNode(cJSON_GetArrayItem(assets, i));
+		GitHubInterface::AssetData asset;
+		ReadJSONAccess::ReadJSON(assetNode, "name", asset.name);
+		ReadJSONAccess::ReadJSON(assetNode, "size", asset.fileSize);
+		ReadJSONAccess::ReadJSON(assetNode, "download_count", asset.downloadCount);
+		release.assets.push_back(asset);
+	}
+}
+
+static void ReadRelease(const JSONTapeNode& node, GitHubInterface::ReleaseData& release)
+{
+	ReadJSONAccess::ReadJSON(node, "tag_name", release.tag);
+	ReadJSONAccess::ReadJSON(node, "created_at", release.creationTime);
+
+	const JSONTapeNode assets(node.GetMember("assets"));
+	for (JSONTapeNode assetNode(assets.GetFirstChild()); assetNode.IsValid(); assetNode = assetNode.GetNext())
+	{
+		GitHubInterface::AssetData asset;
+		ReadJSONAccess::ReadJSON(assetNode, "name", asset.name);
+		ReadJSONAccess::ReadJSON(assetNode, "size", asset.fileSize);
+		ReadJSONAccess::ReadJSON(assetNode, "download_count", asset.downloadCount);
+		release.assets.push_back(asset);
+	}
+}
+
+static void RunCJSONBenchmarks(const std::string& prefix, const std::string& payload)
+{
+	RunBenchmark(prefix + "cJSON_Parse", payload.length(), [&payload](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			cJSON* root(cJSON_Parse(payload.c_str()));
+			DoNotOptimize(root);
+			state.PauseTiming();
+			cJSON_Delete(root);
+			state.ResumeTiming();
+		}
+	});
+
+	RunBenchmark(prefix + "cJSON_Delete", 0, [&payload](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			state.PauseTiming();
+			cJSON* root(cJSON_Parse(payload.c_str()));
+			state.ResumeTiming();
+			cJSON_Delete(root);
+		}
+	});
+}
+
+static void RunReposBenchmarks(const unsigned int& count)
+{
+	const std::string payload(GenerateReposPayload(count));
+	const std::string prefix("repos/" + std::to_string(count) + "/");
+
+	RunCJSONBenchmarks(prefix, payload);
+
+	cJSON* root(cJSON_Parse(payload.c_str()));
+	RunBenchmark(prefix + "ReadJSON (cJSON)", 0, [root](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			std::vector<GitHubInterface::RepoInfo> repos;
+			for (cJSON* node(root->child); node; node = node->next)
+			{
+				GitHubInterface::RepoInfo repo;
+				ReadRepo(node, repo);
+				repos.push_back(repo);
+			}
+			DoNotOptimize(repos.data());
+		}
+	});
+	cJSON_Delete(root);
+
+	RunBenchmark(prefix + "DecodeRepos", payload.length(), [&payload](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			std::vector<GitHubInterface::RepoInfo> repos;
+			GitHubInterface::DecodeRepos(payload, repos);
+			DoNotOptimize(repos.data());
+		}
+	});
+
+	RunBenchmark(prefix + "JSONEventParser (no-op handler)", payload.length(), [&payload](BenchmarkState& state)
+	{
+		JSONEventHandler handler;
+		JSONEventParser parser(handler);
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			parser.Reset();
+			DoNotOptimize(parser.Parse(payload) && parser.Finish());
+		}
+	});
+}
+
+static void RunReleasesBenchmarks(const unsigned int& count)
+{
+	const std::string payload(GenerateReleasesPayload(count));
+	const std::string prefix("releases/" + std::to_string(count) + "/");
+
+	RunCJSONBenchmarks(prefix, payload);
+
+	cJSON* root(cJSON_Parse(payload.c_str()));
+	RunBenchmark(prefix + "ReadJSON (cJSON)", 0, [root](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			std::vector<GitHubInterface::ReleaseData> releases;
+			const int releaseCount(cJSON_GetArraySize(root));
+			for (int j = 0; j < releaseCount; ++j)
+			{
+				GitHubInterface::ReleaseData release;
+				ReadRelease(cJSON_GetArrayItem(root, j), release);
+				releases.push_back(release);
+			}
+			DoNotOptimize(releases.data());
+		}
+	});
+	cJSON_Delete(root);
+
+	RunBenchmark(prefix + "cJSON_Parse + GetReleaseData", payload.length(), [&payload](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			cJSON* root(cJSON_Parse(payload.c_str()));
+			std::vector<GitHubInterface::ReleaseData> releases;
+			const int releaseCount(cJSON_GetArraySize(root));
+			for (int j = 0; j < releaseCount; ++j)
+			{
+				GitHubInterface::ReleaseData release;
+				ReadRelease(cJSON_GetArrayItem(root, j), release);
+				releases.push_back(release);
+			}
+			cJSON_Delete(root);
+			DoNotOptimize(releases.data());
+		}
+	});
+
+	JSONTape tape;
+	tape.Parse(payload);
+	RunBenchmark(prefix + "ReadJSON (tape)", 0, [&tape](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			std::vector<GitHubInterface::ReleaseData> releases;
+			const JSONTapeNode root(tape.GetRoot());
+			for (JSONTapeNode node(root.GetFirstChild()); node.IsValid(); node = node.GetNext())
+			{
+				GitHubInterface::ReleaseData release;
+				ReadRelease(node, release);
+				releases.push_back(release);
+			}
+			DoNotOptimize(releases.data());
+		}
+	});
+
+	RunBenchmark(prefix + "JSONTape::Parse", payload.length(), [&payload](BenchmarkState& state)
+	{
+		JSONTape tape;
+		for (size_t i = 0; i < state.iterations; ++i)
+			DoNotOptimize(tape.Parse(payload));
+	});
+
+	RunBenchmark(prefix + "DecodeReleases", payload.length(), [&payload](BenchmarkState& state)
+	{
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			std::vector<GitHubInterface::ReleaseData> releases;
+			GitHubInterface::DecodeReleases(payload, releases);
+			DoNotOptimize(releases.data());
+		}
+	});
+}
+
+void RunJSONBenchmarks()
+{
+	const unsigned int sizes[] = { 10, 100, 1000 };
+
+	PrintBenchmarkHeader("Repos responses");
+	for (const auto& size : sizes)
+		RunReposBenchmarks(size);
+
+	PrintBenchmarkHeader("Releases responses");
+	for (const auto& size : sizes)
+		RunReleasesBenchmarks(size);
+}
@@ -0,0 +1,136 @@
+// File:  payloads.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Generates GitHub-shaped API responses for benchmarking.  The output
+//        is deterministic, and includes the fields we ignore as well as the
+//        ones we read, so parsers see realistic skip-to-read ratios.
+
+// Local headers
+#include "payloads.h"
+
+// Standard C++ headers
+#include <sstream>
+
+static const char* const languages[] = { "C++", "C", "Python", "MATLAB", "JavaScript", "Shell" };
+static const char* const assetSuffixes[] = { "-win64.exe", "-win32.msi", "-macos.dmg", "-x86_64.AppImage", "_amd64.deb", ".tar.gz" };
+
+static void WriteUser(std::ostringstream& ss, const std::string& login, const unsigned int& id)
+{
+	ss << "{\"login\":\"" << login << "\",\"id\":" << id
+		<< ",\"node_id\":\"MDQ6VXNlcj" << id << "=\""
+		<< ",\"avatar_url\":\"https://avatars.githubusercontent.com/u/" << id << "?v=4\""
+		<< ",\"gravatar_id\":\"\""
+		<< ",\"url\":\"https://api.github.com/users/" << login << "\""
+		<< ",\"html_url\":\"https://github.com/" << login << "\""
+		<< ",\"followers_url\":\"https://api.github.com/users/" << login << "/followers\""
+		<< ",\"repos_url\":\"https://api.github.com/users/" << login << "/repos\""
+		<< ",\"type\":\"User\",\"site_admin\":false}";
+}
+
+static void WriteTimestamp(std::ostringstream& ss, const unsigned int& seed)
+{
+	ss << '"' << 2012 + seed % 12 << "-0" << 1 + seed % 9
+		<< '-' << 10 + seed % 18 << 'T' << 10 + seed % 13 << ':' << 10 + seed % 49
+		<< ':' << 10 + seed % 47 << "Z\"";
+}
+
+std::string GenerateReposPayload(const unsigned int& repoCount)
+{
+	const std::string login("octo-dev");
+	std::ostringstream ss;
+	ss << '[';
+	for (unsigned int i = 0; i < repoCount; ++i)
+	{
+		if (i > 0)
+			ss << ',';
+
+		const std::string name("project-" + std::to_string(i));
+		const std::string api("https://api.github.com/repos/" + login + "/" + name);
+		ss << "{\"id\":" << 1000000 + i
+			<< ",\"node_id\":\"MDEwOlJlcG9zaXRvcnk" << i << "=\""
+			<< ",\"name\":\"" << name << "\""
+			<< ",\"full_name\":\"" << login << '/' << name << "\""
+			<< ",\"private\":false,\"owner\":";
+		WriteUser(ss, login, 4242);
+		ss << ",\"html_url\":\"https://github.com/" << login << '/' << name << "\""
+			<< ",\"description\":\"Tools for \\\"" << name << "\\\" \\u2013 analysis and plotting\""
+			<< ",\"fork\":" << (i % 7 == 0 ? "true" : "false")
+			<< ",\"url\":\"" << api << "\""
+			<< ",\"forks_url\":\"" << api << "/forks\""
+			<< ",\"issues_url\":\"" << api << "/issues{/number}\""
+			<< ",\"releases_url\":\"" << api << "/releases{/id}\""
+			<< ",\"created_at\":";
+		WriteTimestamp(ss, i);
+		ss << ",\"updated_at\":";
+		WriteTimestamp(ss, i * 7 + 3);
+		ss << ",\"pushed_at\":";
+		WriteTimestamp(ss, i * 5 + 1);
+		ss << ",\"git_url\":\"git://github.com/" << login << '/' << name << ".git\""
+			<< ",\"homepage\":null,\"size\":" << 100 + i * 37
+			<< ",\"stargazers_count\":" << i % 50
+			<< ",\"watchers_count\":" << i % 50
+			<< ",\"language\":\"" << languages[i % (sizeof(languages) / sizeof(languages[0]))] << "\""
+			<< ",\"has_issues\":true,\"has_wiki\":true,\"has_pages\":false"
+			<< ",\"forks_count\":" << i % 5
+			<< ",\"license\":{\"key\":\"mit\",\"name\":\"MIT License\",\"spdx_id\":\"MIT\",\"url\":null}"
+			<< ",\"topics\":[\"engineering\",\"simulation\"]"
+			<< ",\"visibility\":\"public\",\"default_branch\":\"master\"}";
+	}
+	ss << ']';
+	return ss.str();
+}
+
+std::string GenerateReleasesPayload(const unsigned int& releaseCount, const unsigned int& assetsPerRelease)
+{
+	const std::string api("https://api.github.com/repos/octo-dev/project");
+	std::ostringstream ss;
+	ss << '[';
+	for (unsigned int i = 0; i < releaseCount; ++i)
+	{
+		if (i > 0)
+			ss << ',';
+
+		const std::string tag("v" + std::to_string(1 + i / 10) + "." + std::to_string(i % 10));
+		ss << "{\"url\":\"" << api << "/releases/" << 5000 + i << "\""
+			<< ",\"assets_url\":\"" << api << "/releases/" << 5000 + i << "/assets\""
+			<< ",\"html_url\":\"https://github.com/octo-dev/project/releases/tag/" << tag << "\""
+			<< ",\"id\":" << 5000 + i
+			<< ",\"author\":";
+		WriteUser(ss, "octo-dev", 4242);
+		ss << ",\"tag_name\":\"" << tag << "\""
+			<< ",\"target_commitish\":\"master\""
+			<< ",\"name\":\"Release " << tag << "\""
+			<< ",\"draft\":false,\"prerelease\":" << (i % 4 == 0 ? "true" : "false")
+			<< ",\"created_at\":";
+		WriteTimestamp(ss, i);
+		ss << ",\"published_at\":";
+		WriteTimestamp(ss, i + 1);
+		ss << ",\"assets\":[";
+		for (unsigned int j = 0; j < assetsPerRelease; ++j)
+		{
+			if (j > 0)
+				ss << ',';
+			const std::string assetName("project-" + tag + assetSuffixes[j % (sizeof(assetSuffixes) / sizeof(assetSuffixes[0]))]);
+			ss << "{\"url\":\"" << api << "/releases/assets/" << 90000 + i * 10 + j << "\""
+				<< ",\"id\":" << 90000 + i * 10 + j
+				<< ",\"name\":\"" << assetName << "\""
+				<< ",\"label\":\"\",\"uploader\":";
+			WriteUser(ss, "octo-dev", 4242);
+			ss << ",\"content_type\":\"application/octet-stream\",\"state\":\"uploaded\""
+				<< ",\"size\":" << 1048576 + i * 7919 + j * 104729
+				<< ",\"download_count\":" << (i * 131 + j * 17) % 100000
+				<< ",\"created_at\":";
+			WriteTimestamp(ss, i + j);
+			ss << ",\"updated_at\":";
+			WriteTimestamp(ss, i + j + 1);
+			ss << ",\"browser_download_url\":\"https://github.com/octo-dev/project/releases/download/"
+				<< tag << '/' << assetName << "\"}";
+		}
+		ss << "],\"tarball_url\":\"" << api << "/tarball/" << tag << "\""
+			<< ",\"zipball_url\":\"" << api << "/zipball/" << tag << "\""
+			<< ",\"body\":\"## Changes\\r\\n\\r\\n* Fixed \\\"issue\\\" #" << i
+			<< "\\r\\n* Improved solver stability\\r\\n* Updated build scripts\\r\\n\\r\\nSHA-256 checksums are listed below.\"}";
+	}
+	ss << ']';
+	return ss.str();
+}
@@ -0,0 +1,21 @@
+// File:  payloads.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Generates GitHub-shaped API responses for benchmarking.  The output
+//        is deterministic, and includes the fields we ignore as well as the
+//        ones we read, so parsers see realistic skip-to-read ratios.
+
+#ifndef PAYLOADS_H_
+#define PAYLOADS_H_
+
+// Standard C++ headers
+#include <string>
+
+// Equivalent of a /users/{user}/repos response with the specified number of repos
+std::string GenerateReposPayload(const unsigned int& repoCount);
+
+// Equivalent of a /repos/{user}/{repo}/releases response
+std::string GenerateReleasesPayload(const unsigned int& releaseCount,
+	const unsigned int& assetsPerRelease = 3);
+
+#endif// PAYLOADS_H_
@@ -0,0 +1,172 @@
+// File:  tableBenchmarks.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Benchmarks for printing the --all table:  the buffered renderer
+//        against the previous stream manipulators with a flush per line.
+
+// Local headers
+#include "benchmark.h"
+#include "tableRenderer.h"
+#include "timestamp.h"
+
+// Standard C++ headers
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <cstdio>
+#include <algorithm>
+
+struct Row
+{
+	std::string name;
+	Timestamp updated;
+	std::string language;
+	uint64_t releases;
+	uint64_t total;
+	uint64_t latest;
+	int64_t delta;
+};
+
+static std::vector<Row> GenerateRows(const size_t& count)
+{
+	const char* languages[] = { "C++", "C", "Python", "MATLAB", "JavaScript", "" };
+	std::vector<Row> rows;
+	uint64_t seed(0x9E3779B97F4A7C15);
+	for (size_t i = 0; i < count; ++i)
+	{
+		seed = seed * 6364136223846793005 + 1442695040888963407;
+		const uint64_t r(seed >> 16);
+		rows.push_back({ "repository-" + std::to_string(i) + std::string(r % 17, 'x'),
+			Timestamp(1500000000 + static_cast<int64_t>(r % 300000000)),
+			languages[r % (sizeof(languages) / sizeof(languages[0]))],
+			r % 120, r % 2000000, r % 50000, static_cast<int64_t>(r % 200) - 20 });
+	}
+	return rows;
+}
+
+static void BuildTable(const std::vector<Row>& rows, TableRenderer& table)
+{
+	table.AddColumn("Repo Name");
+	table.AddColumn("Last Update");
+	table.AddColumn("Language");
+	table.AddColumn("Releases");
+	table.AddColumn("Total");
+	table.AddColumn("Latest");
+	table.AddColumn("Delta");
+	table.Reserve(rows.size(), 64);
+
+	for (const auto& row : rows)
+	{
+		char date[Timestamp::maxLength];
+		table.AddCell(row.name);
+		table.AddCell(std::string_view(date, row.updated.FormatDate(date)));
+		table.AddCell(row.language);
+		table.AddCell(row.releases);
+		table.AddCell(row.total);
+		table.AddCell(row.latest);
+		table.AddCell(row.delta, true);
+	}
+}
+
+// The formatting GetAllStats() used before the renderer
+static void WriteWithStreams(const std::vector<Row>& rows, std::ostream& out)
+{
+	size_t widths[] = { 9, 11, 8, 8, 5, 6, 5 };
+	for (const auto& row : rows)
+	{
+		widths[0] = std::max(widths[0], row.name.length());
+		widths[2] = std::max(widths[2], row.language.length());
+	}
+
+	const char* headings[] = { "Repo Name", "Last Update", "Language", "Releases", "Total", "Latest", "Delta" };
+	size_t width(12);
+	for (size_t i = 0; i < 7; ++i)
+	{
+		out << (i > 0 ? "  " : "") << std::left << std::setw(widths[i]) << std::setfill(' ') << headings[i];
+		width += widths[i];
+	}
+	out << '\n' << std::setw(width) << std::setfill('-') << '-' << std::endl;
+
+	for (const auto& row : rows)
+	{
+		out << std::left << std::setw(widths[0]) << std::setfill(' ') << row.name << "  ";
+		out << std::left << std::setw(widths[1]) << std::setfill(' ') << row.updated.ToDateString() << "  ";
+		out << std::left << std::setw(widths[2]) << std::setfill(' ') << row.language << "  ";
+		out << std::left << std::setw(widths[3]) << std::setfill(' ') << row.releases << "  ";
+		out << std::left << std::setw(widths[4]) << std::setfill(' ') << row.total << "  ";
+		out << std::left << std::setw(widths[5]) << std::setfill(' ') << row.latest << "  ";
+		out << std::left << std::setw(widths[6]) << std::setfill(' ');
+		if (row.delta > 0)
+			out << std::showpos << row.delta << std::noshowpos;
+		else
+			out << row.delta;
+		out << std::endl;
+	}
+}
+
+void RunTableBenchmarks()
+{
+	const size_t rowCount(10000);
+	const std::vector<Row> rows(GenerateRows(rowCount));
+	const std::string prefix("all/" + std::to_string(rowCount) + "/");
+
+	std::string rendered;
+	{
+		TableRenderer table;
+		BuildTable(rows, table);
+		table.Render(rendered);
+	}
+
+	PrintBenchmarkHeader("--all table");
+	RunBenchmark(prefix + "TableRenderer (build + render)", rendered.length(), [&rows](BenchmarkState& state)
+	{
+		std::string buffer;
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			TableRenderer table;
+			BuildTable(rows, table);
+			table.Render(buffer);
+			DoNotOptimize(buffer.data());
+		}
+	});
+
+	// Both write to a regular file, so the difference is formatting plus the
+	// per-line flushes
+	const std::string fileName((std::filesystem::temp_directory_path() / "gitHubStatsTable.txt").string());
+
+	RunBenchmark(prefix + "TableRenderer::Write", rendered.length(), [&rows, &fileName](BenchmarkState& state)
+	{
+		FILE* file(fopen(fileName.c_str(), "wb"));
+		if (!file)
+			return;
+
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			state.PauseTiming();
+			rewind(file);
+			state.ResumeTiming();
+
+			TableRenderer table;
+			BuildTable(rows, table);
+			table.Write(file);
+		}
+		fclose(file);
+	});
+
+	RunBenchmark(prefix + "iostream setw + endl", rendered.length(), [&rows, &fileName](BenchmarkState& state)
+	{
+		std::ofstream file(fileName, std::ios::binary);
+		for (size_t i = 0; i < state.iterations; ++i)
+		{
+			state.PauseTiming();
+			file.seekp(0);
+			state.ResumeTiming();
+
+			WriteWithStreams(rows, file);
+		}
+	});
+
+	std::error_code error;
+	std::filesystem::remove(fileName, error);
+}
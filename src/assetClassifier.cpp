@@ -0,0 +1,262 @@
+// File:  assetClassifier.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Rule engine deciding which asset of a release is its "best" (i.e.
+//        counted) download.  Rules are compiled into a single matcher and each
+//        distinct asset name is matched once, with the result cached by its
+//        interned id.
+
+// Local headers
+#include "assetClassifier.h"
+
+// Standard C++ headers
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+static char ToLower(const char& c)
+{
+	return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+static const char platformPrefix[] = "platform:";
+
+struct PlatformSuffixes
+{
+	const char* platform;
+	std::vector<const char*> suffixes;
+};
+
+static const std::vector<PlatformSuffixes> platforms = {
+	{ "windows", { ".exe", ".msi" } },
+	{ "macos", { ".dmg" } },
+	{ "linux", { ".appimage", ".deb" } }
+};
+
+AssetClassifier& AssetClassifier::Get()
+{
+	static AssetClassifier classifier;
+	return classifier;
+}
+
+AssetClassifier::AssetClassifier() : cacheSegments(new std::atomic<std::atomic<uint8_t>*>[maxCacheSegments])
+{
+	for (size_t i = 0; i < maxCacheSegments; ++i)
+		cacheSegments[i].store(nullptr, std::memory_order_relaxed);
+
+	SetDefaultRules();
+}
+
+void AssetClassifier::ClearRules()
+{
+	suffixTrie.assign(1, SuffixNode());
+	globRules.clear();
+	ClearCache();
+}
+
+void AssetClassifier::SetDefaultRules()
+{
+	ClearRules();
+	for (const auto& p : platforms)
+		AddRule(std::string(platformPrefix) + p.platform, 1);
+}
+
+bool AssetClassifier::LoadRules(const std::string& fileName)
+{
+	std::ifstream file(fileName.c_str());
+	if (!file.is_open() || !file.good())
+	{
+		std::cerr << "Failed to open '" << fileName << "' for input\n";
+		return false;
+	}
+
+	ClearRules();
+
+	std::string line;
+	unsigned int lineNumber(0);
+	while (std::getline(file, line))
+	{
+		++lineNumber;
+		const size_t start(line.find_first_not_of(" \t\r"));
+		if (start == std::string::npos || line[start] == '#')
+			continue;
+
+		std::istringstream ss(line);
+		unsigned int priority;
+		std::string pattern;
+		if (!(ss >> priority >> pattern) || priority > maxPriority || !AddRule(pattern, static_cast<Priority>(priority)))
+		{
+			std::cerr << "Invalid rule on line " << lineNumber << " of '" << fileName << "'\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool AssetClassifier::AddRule(const std::string_view& pattern, const Priority& priority)
+{
+	if (pattern.empty() || priority > maxPriority)
+		return false;
+
+	std::string lower(pattern);
+	std::transform(lower.begin(), lower.end(), lower.begin(), ToLower);
+
+	const size_t prefixLength(sizeof(platformPrefix) - 1);
+	if (lower.compare(0, prefixLength, platformPrefix) == 0)
+	{
+		for (const auto& p : platforms)
+		{
+			if (lower.compare(prefixLength, std::string::npos, p.platform) == 0)
+			{
+				for (const auto& suffix : p.suffixes)
+					AddSuffix(suffix, priority);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	const size_t wildcard(lower.find_first_of("*?"));
+	if (wildcard == std::string::npos && lower.front() == '.')
+		AddSuffix(lower, priority);
+	else if (wildcard == 0 && lower.length() > 1 && lower.find_first_of("*?", 1) == std::string::npos)
+		AddSuffix(std::string_view(lower).substr(1), priority);
+	else
+		globRules.push_back({ lower, priority });
+
+	ClearCache();
+	return true;
+}
+
+void AssetClassifier::AddSuffix(const std::string_view& suffix, const Priority& priority)
+{
+	uint32_t node(0);
+	for (auto c = suffix.rbegin(); c != suffix.rend(); ++c)
+	{
+		const char lower(ToLower(*c));
+		auto& children(suffixTrie[node].children);
+		auto child(std::find_if(children.begin(), children.end(),
+			[lower](const std::pair<char, uint32_t>& p) { return p.first == lower; }));
+		if (child == children.end())
+		{
+			const uint32_t next(static_cast<uint32_t>(suffixTrie.size()));
+			suffixTrie[node].children.emplace_back(lower, next);
+			suffixTrie.emplace_back();
+			node = next;
+		}
+		else
+			node = child->second;
+	}
+
+	suffixTrie[node].priority = std::max(suffixTrie[node].priority, priority);
+}
+
+// Iterative matcher for '*' (any run) and '?' (any one character); only the
+// most recent '*' needs to be revisited on a mismatch
+bool AssetClassifier::GlobMatch(const std::string_view& pattern, const std::string_view& name)
+{
+	size_t p(0), n(0);
+	size_t starP(std::string_view::npos), starN(0);
+	while (n < name.length())
+	{
+		if (p < pattern.length() && (pattern[p] == '?' || pattern[p] == ToLower(name[n])))
+		{
+			++p;
+			++n;
+		}
+		else if (p < pattern.length() && pattern[p] == '*')
+		{
+			starP = p++;
+			starN = n;
+		}
+		else if (starP != std::string_view::npos)
+		{
+			p = starP + 1;
+			n = ++starN;
+		}
+		else
+			return false;
+	}
+
+	while (p < pattern.length() && pattern[p] == '*')
+		++p;
+	return p == pattern.length();
+}
+
+AssetClassifier::Priority AssetClassifier::Classify(const std::string_view& name) const
+{
+	// The whole name must not be consumed by a suffix (".exe" isn't an installer)
+	Priority priority(0);
+	uint32_t node(0);
+	for (size_t i = name.length(); i > 1; --i)
+	{
+		const char lower(ToLower(name[i - 1]));
+		const auto& children(suffixTrie[node].children);
+		auto child(std::find_if(children.begin(), children.end(),
+			[lower](const std::pair<char, uint32_t>& p) { return p.first == lower; }));
+		if (child == children.end())
+			break;
+
+		node = child->second;
+		priority = std::max(priority, suffixTrie[node].priority);
+	}
+
+	for (const auto& rule : globRules)
+	{
+		if (rule.priority > priority && GlobMatch(rule.pattern, name))
+			priority = rule.priority;
+	}
+
+	return priority;
+}
+
+AssetClassifier::Priority AssetClassifier::Classify(const InternedString& name)
+{
+	const size_t segment(name.GetId() / cacheSegmentSize);
+	if (segment >= maxCacheSegments)
+		return Classify(name.View());
+
+	// Two threads may classify the same name at once; both store the same value
+	std::atomic<uint8_t>& entry(GetCacheSegment(segment)[name.GetId() % cacheSegmentSize]);
+	const uint8_t cached(entry.load(std::memory_order_relaxed));
+	if (cached != 0)
+		return cached - 1;
+
+	const Priority priority(Classify(name.View()));
+	entry.store(priority + 1, std::memory_order_relaxed);
+	return priority;
+}
+
+std::atomic<uint8_t>* AssetClassifier::GetCacheSegment(const size_t& segment)
+{
+	std::atomic<uint8_t>* entries(cacheSegments[segment].load(std::memory_order_acquire));
+	if (entries)
+		return entries;
+
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	entries = cacheSegments[segment].load(std::memory_order_relaxed);
+	if (!entries)
+	{
+		cacheStorage.emplace_back(new std::atomic<uint8_t>[cacheSegmentSize]);
+		entries = cacheStorage.back().get();
+		for (size_t i = 0; i < cacheSegmentSize; ++i)
+			entries[i].store(0, std::memory_order_relaxed);
+		cacheSegments[segment].store(entries, std::memory_order_release);
+	}
+
+	return entries;
+}
+
+// Rules only change before decoding starts, so no lookups are in flight
+void AssetClassifier::ClearCache()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+	for (const auto& entries : cacheStorage)
+	{
+		for (size_t i = 0; i < cacheSegmentSize; ++i)
+			entries[i].store(0, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,95 @@
+// File:  assetClassifier.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Rule engine deciding which asset of a release is its "best" (i.e.
+//        counted) download.  Rules are compiled into a single matcher and each
+//        distinct asset name is matched once, with the result cached by its
+//        interned id.
+
+#ifndef ASSET_CLASSIFIER_H_
+#define ASSET_CLASSIFIER_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+// Local headers
+#include "stringInterner.h"
+
+class AssetClassifier
+{
+public:
+	static AssetClassifier& Get();
+
+	// Zero means the asset isn't preferred; otherwise higher is better
+	typedef uint8_t Priority;
+	static constexpr Priority maxPriority = 254;// The cache stores priority + 1
+
+	// True if candidate should replace current as the counted asset of a
+	// release.  Ties between preferred assets go to the later one.
+	static bool Prefer(const Priority& candidate, const Priority& current)
+	{
+		return candidate > current || (candidate == current && candidate > 0);
+	}
+
+	// Rules must be in place before any decoding starts.  The defaults are the
+	// installers for Windows, macOS and Linux (priority 1).
+	void SetDefaultRules();
+
+	// Replaces the current rules with the contents of the file.  Each line is
+	// "<priority> <pattern>", blank lines and lines starting with '#' are
+	// ignored.  A pattern is a file suffix (.deb), a glob (*-setup-*.zip) or a
+	// platform (platform:windows, platform:macos or platform:linux), which
+	// stands for that platform's installer suffixes.  Matching ignores case.
+	bool LoadRules(const std::string& fileName);
+	bool AddRule(const std::string_view& pattern, const Priority& priority);// Up to maxPriority
+	void ClearRules();
+
+	// Highest priority of all matching rules
+	Priority Classify(const std::string_view& name) const;
+	Priority Classify(const InternedString& name);// Cached; does not lock once warm
+
+private:
+	AssetClassifier();
+	AssetClassifier(const AssetClassifier&) = delete;
+	AssetClassifier& operator=(const AssetClassifier&) = delete;
+
+	// Suffix rules (including globs of the form *.ext) share a trie keyed on
+	// the reversed, lower-case suffix
+	struct SuffixNode
+	{
+		Priority priority = 0;
+		std::vector<std::pair<char, uint32_t>> children;
+	};
+	std::vector<SuffixNode> suffixTrie;
+
+	struct GlobRule
+	{
+		std::string pattern;// Lower case
+		Priority priority;
+	};
+	std::vector<GlobRule> globRules;
+
+	void AddSuffix(const std::string_view& suffix, const Priority& priority);
+	static bool GlobMatch(const std::string_view& pattern, const std::string_view& name);
+
+	// Indexed by interned id; holds priority + 1, or zero if not yet
+	// classified.  Entries live in fixed-size segments reached through a
+	// directory that is never reallocated (as in StringInterner), so lookups
+	// from the decode workers only lock to allocate a segment.
+	static constexpr size_t cacheSegmentSize = 4096;
+	static constexpr size_t maxCacheSegments = 16384;
+	std::mutex cacheMutex;
+	std::unique_ptr<std::atomic<std::atomic<uint8_t>*>[]> cacheSegments;
+	std::vector<std::unique_ptr<std::atomic<uint8_t>[]>> cacheStorage;
+
+	std::atomic<uint8_t>* GetCacheSegment(const size_t& segment);
+	void ClearCache();
+};
+
+#endif// ASSET_CLASSIFIER_H_
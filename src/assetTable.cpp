@@ -0,0 +1,238 @@
+// File:  assetTable.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Columnar (struct-of-arrays) store of release assets.  Each asset is
+//        one row; rows are grouped by release and releases by repo, so every
+//        per-repo aggregate is a single pass over contiguous arrays.
+
+// Local headers
+#include "assetTable.h"
+#include "checkedMath.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+void AssetTable::BeginRepo(const uint32_t& r)
+{
+	assert(repoReleaseBegin.empty() || r + 1 >= repoReleaseBegin.size());
+	while (repoReleaseBegin.size() <= r)
+	{
+		repoReleaseBegin.push_back(static_cast<uint32_t>(releaseTag.size()));
+		repoRowBegin.push_back(static_cast<uint32_t>(downloadCount.size()));
+	}
+}
+
+void AssetTable::AddRelease(const uint32_t& r, const InternedString& tag, const int64_t& time)
+{
+	BeginRepo(r);
+	releaseTag.push_back(tag);
+	releaseCreated.push_back(time);
+	releaseRepo.push_back(r);
+	releaseHasRows = false;
+}
+
+void AssetTable::AddAsset(const InternedString& assetName, const uint64_t& assetSize,
+	const uint64_t& count, const AssetClassifier::Priority& assetPriority)
+{
+	assert(!releaseTag.empty());
+	const size_t row(downloadCount.size());
+
+	uint8_t f(assetPriority > 0 ? Preferred : 0);
+	if (!releaseHasRows)
+	{
+		f |= Counted;
+		countedRow = row;
+		countedPriority = assetPriority;
+		releaseHasRows = true;
+	}
+	else if (AssetClassifier::Prefer(assetPriority, countedPriority))
+	{
+		flags[countedRow] &= ~Counted;
+		f |= Counted;
+		countedRow = row;
+		countedPriority = assetPriority;
+	}
+
+	repo.push_back(releaseRepo.back());
+	release.push_back(static_cast<uint32_t>(releaseTag.size() - 1));
+	created.push_back(releaseCreated.back());
+	size.push_back(assetSize);
+	downloadCount.push_back(count);
+	flags.push_back(f);
+	priority.push_back(assetPriority);
+	name.push_back(assetName);
+}
+
+void AssetTable::Append(const uint32_t& r, const std::vector<GitHubInterface::ReleaseData>& releases)
+{
+	BeginRepo(r);
+	for (const auto& item : releases)
+	{
+		AddRelease(r, item.tag, item.creationTime.GetSeconds());
+		for (const auto& asset : item.assets)
+			AddAsset(asset.name, asset.fileSize, asset.downloadCount, asset.priority);
+	}
+}
+
+void AssetTable::Append(const uint32_t& r, const AssetTable& other)
+{
+	BeginRepo(r);
+	const uint32_t releaseOffset(static_cast<uint32_t>(releaseTag.size()));
+	const size_t rowOffset(downloadCount.size());
+
+	releaseTag.insert(releaseTag.end(), other.releaseTag.begin(), other.releaseTag.end());
+	releaseCreated.insert(releaseCreated.end(), other.releaseCreated.begin(), other.releaseCreated.end());
+	releaseRepo.resize(releaseTag.size(), r);
+
+	repo.resize(rowOffset + other.GetRowCount(), r);
+	release.resize(rowOffset + other.GetRowCount());
+	for (size_t i = 0; i < other.GetRowCount(); ++i)
+		release[rowOffset + i] = other.release[i] + releaseOffset;
+	created.insert(created.end(), other.created.begin(), other.created.end());
+	size.insert(size.end(), other.size.begin(), other.size.end());
+	downloadCount.insert(downloadCount.end(), other.downloadCount.begin(), other.downloadCount.end());
+	flags.insert(flags.end(), other.flags.begin(), other.flags.end());
+	priority.insert(priority.end(), other.priority.begin(), other.priority.end());
+	name.insert(name.end(), other.name.begin(), other.name.end());
+
+	if (!other.releaseTag.empty())
+	{
+		releaseHasRows = other.releaseHasRows;
+		countedRow = other.countedRow + rowOffset;
+		countedPriority = other.countedPriority;
+	}
+}
+
+void AssetTable::Reserve(const size_t& releaseCount, const size_t& rowCount)
+{
+	releaseTag.reserve(releaseCount);
+	releaseCreated.reserve(releaseCount);
+	releaseRepo.reserve(releaseCount);
+
+	repo.reserve(rowCount);
+	release.reserve(rowCount);
+	created.reserve(rowCount);
+	size.reserve(rowCount);
+	downloadCount.reserve(rowCount);
+	flags.reserve(rowCount);
+	priority.reserve(rowCount);
+	name.reserve(rowCount);
+}
+
+void AssetTable::Clear()
+{
+	repo.clear();
+	release.clear();
+	created.clear();
+	size.clear();
+	downloadCount.clear();
+	flags.clear();
+	priority.clear();
+	name.clear();
+
+	releaseTag.clear();
+	releaseCreated.clear();
+	releaseRepo.clear();
+
+	repoReleaseBegin.clear();
+	repoRowBegin.clear();
+
+	countedRow = 0;
+	countedPriority = 0;
+	releaseHasRows = false;
+}
+
+void AssetTable::Release()
+{
+	*this = AssetTable();
+}
+
+void AssetTable::GetReleaseRange(const uint32_t& r, size_t& begin, size_t& end) const
+{
+	if (r >= repoReleaseBegin.size())
+	{
+		begin = end = releaseTag.size();
+		return;
+	}
+
+	begin = repoReleaseBegin[r];
+	end = r + 1 < repoReleaseBegin.size() ? repoReleaseBegin[r + 1] : releaseTag.size();
+}
+
+void AssetTable::GetRowRange(const uint32_t& r, size_t& begin, size_t& end) const
+{
+	if (r >= repoRowBegin.size())
+	{
+		begin = end = downloadCount.size();
+		return;
+	}
+
+	begin = repoRowBegin[r];
+	end = r + 1 < repoRowBegin.size() ? repoRowBegin[r + 1] : downloadCount.size();
+}
+
+size_t AssetTable::GetReleaseCount(const uint32_t& r) const
+{
+	size_t begin, end;
+	GetReleaseRange(r, begin, end);
+	return end - begin;
+}
+
+AssetTable::RepoSummary AssetTable::Summarize(const uint32_t& r) const
+{
+	RepoSummary summary;
+	summary.releaseCount = GetReleaseCount(r);
+
+	size_t begin, end;
+	GetRowRange(r, begin, end);
+	summary.assetCount = end - begin;
+
+	// Branch-free reductions over the columns so the compiler can vectorize
+	// them.  The upper and lower halves of the counts are summed separately,
+	// which can't overflow for fewer than 2^32 rows, and combined (checked) at
+	// the end.
+	const uint64_t* const counts(downloadCount.data());
+	const int64_t* const times(created.data());
+	const uint8_t* const f(flags.data());
+
+	uint64_t low(0), high(0);
+	int64_t latest(0);
+	for (size_t i = begin; i < end; ++i)
+	{
+		const uint64_t mask(0 - static_cast<uint64_t>((f[i] & Counted) != 0));
+		const uint64_t count(counts[i] & mask);
+		low += count & 0xFFFFFFFF;
+		high += count >> 32;
+		const int64_t time(times[i] & static_cast<int64_t>(mask));
+		latest = time > latest ? time : latest;
+	}
+
+	if (high >> 32 != 0)
+	{
+		summary.totalDownloads = std::numeric_limits<uint64_t>::max();
+		summary.overflow = true;
+	}
+	else
+	{
+		summary.totalDownloads = high << 32;
+		summary.overflow = !CheckedAdd(summary.totalDownloads, low);
+	}
+	summary.latestRelease = latest;
+
+	// Releases dated at or before the epoch are never "latest"
+	if (latest > 0)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			if ((f[i] & Counted) && times[i] == latest)
+			{
+				summary.latestDownloads = counts[i];
+				break;
+			}
+		}
+	}
+
+	return summary;
+}
@@ -0,0 +1,100 @@
+// File:  assetTable.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Columnar (struct-of-arrays) store of release assets.  Each asset is
+//        one row; rows are grouped by release and releases by repo, so every
+//        per-repo aggregate is a single pass over contiguous arrays.
+
+#ifndef ASSET_TABLE_H_
+#define ASSET_TABLE_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Local headers
+#include "stringInterner.h"
+#include "gitHubInterface.h"
+#include "assetClassifier.h"
+
+class AssetTable
+{
+public:
+	enum Flags : uint8_t
+	{
+		Preferred = 1 << 0,// Has a non-zero classifier priority
+		Counted = 1 << 1// Represents its release in download totals
+	};
+
+	// Repos must be added in ascending order (gaps are allowed); each asset
+	// belongs to the most recently added release.  The counted asset of each
+	// release is the first one, unless an asset with higher priority follows.
+	void AddRelease(const uint32_t& repo, const InternedString& tag, const int64_t& created);
+	void AddAsset(const InternedString& name, const uint64_t& size,
+		const uint64_t& downloadCount, const AssetClassifier::Priority& priority);
+
+	void Append(const uint32_t& repo, const std::vector<GitHubInterface::ReleaseData>& releases);
+	// Rows of a single-repo table are re-assigned to the specified repo
+	void Append(const uint32_t& repo, const AssetTable& other);
+
+	void Reserve(const size_t& releaseCount, const size_t& rowCount);
+	void Clear();// Keeps allocated capacity
+	void Release();// Frees everything
+
+	size_t GetRowCount() const { return downloadCount.size(); }
+	size_t GetReleaseCount() const { return releaseTag.size(); }
+
+	size_t GetReleaseCount(const uint32_t& repo) const;
+	void GetRowRange(const uint32_t& repo, size_t& begin, size_t& end) const;
+
+	struct RepoSummary
+	{
+		size_t releaseCount = 0;
+		size_t assetCount = 0;
+		uint64_t totalDownloads = 0;// Counted assets only
+		bool overflow = false;// True if totalDownloads saturated
+		uint64_t latestDownloads = 0;// Counted asset of the newest release
+		int64_t latestRelease = 0;
+	};
+
+	RepoSummary Summarize(const uint32_t& repo) const;
+
+	// Row access
+	InternedString GetName(const size_t& row) const { return name[row]; }
+	InternedString GetTag(const size_t& row) const { return releaseTag[release[row]]; }
+	int64_t GetCreated(const size_t& row) const { return created[row]; }
+	uint64_t GetSize(const size_t& row) const { return size[row]; }
+	uint64_t GetDownloadCount(const size_t& row) const { return downloadCount[row]; }
+	uint8_t GetFlags(const size_t& row) const { return flags[row]; }
+	AssetClassifier::Priority GetPriority(const size_t& row) const { return priority[row]; }
+
+private:
+	// Asset columns
+	std::vector<uint32_t> repo;
+	std::vector<uint32_t> release;
+	std::vector<int64_t> created;// Copied from the release, so aggregates needn't gather
+	std::vector<uint64_t> size;
+	std::vector<uint64_t> downloadCount;
+	std::vector<uint8_t> flags;
+	std::vector<AssetClassifier::Priority> priority;
+	std::vector<InternedString> name;
+
+	// Release columns
+	std::vector<InternedString> releaseTag;
+	std::vector<int64_t> releaseCreated;
+	std::vector<uint32_t> releaseRepo;
+
+	// First release and row of each repo
+	std::vector<uint32_t> repoReleaseBegin;
+	std::vector<uint32_t> repoRowBegin;
+
+	size_t countedRow = 0;// Row currently counted for the last release, if any
+	AssetClassifier::Priority countedPriority = 0;
+	bool releaseHasRows = false;
+
+	void BeginRepo(const uint32_t& r);
+	void GetReleaseRange(const uint32_t& r, size_t& begin, size_t& end) const;
+};
+
+#endif// ASSET_TABLE_H_
@@ -32,7 +32,8 @@
 #include <ctype.h>
 #include "cJSON.h"
 
-static const char *ep;
+/* Error position of the last cJSON_Parse() on this thread.  Parsing itself keeps all state in a cJSON_ParseContext. */
+static thread_local const char *ep;
 
 const char *cJSON_GetErrorPtr(void) {return ep;}
 
@@ -69,7 +70,25 @@ void cJSON_InitHooks(cJSON_Hooks* hooks)
 	cJSON_free	 = (hooks->free_fn)?hooks->free_fn:free;
 }
 
-/* Internal constructor. */
+void cJSON_InitParseContext(cJSON_ParseContext *context)
+{
+	context->hooks.malloc_fn=cJSON_malloc;
+	context->hooks.free_fn=cJSON_free;
+	context->max_depth=cJSON_DefaultMaxDepth;
+	context->max_size=cJSON_DefaultMaxSize;
+	context->max_nodes=cJSON_DefaultMaxNodes;
+	context->error=0;
+	context->error_code=cJSON_ErrorNone;
+}
+
+/* Internal constructors. */
+static cJSON *cJSON_New_Item_With(const cJSON_Hooks *hooks)
+{
+	cJSON* node = (cJSON*)hooks->malloc_fn(sizeof(cJSON));
+	if (node) memset(node,0,sizeof(cJSON));
+	return node;
+}
+
 static cJSON *cJSON_New_Item(void)
 {
 	cJSON* node = (cJSON*)cJSON_malloc(sizeof(cJSON));
@@ -78,20 +97,35 @@ static cJSON *cJSON_New_Item(void)
 }
 
 /* Delete a cJSON structure. */
-void cJSON_Delete(cJSON *c)
+void cJSON_DeleteWithHooks(cJSON *c,const cJSON_Hooks *hooks)
 {
 	cJSON *next;
 	while (c)
 	{
+		if (!(c->type&cJSON_IsReference) && c->child)
+		{
+			/* Splice the children into the chain rather than recursing, so deep trees can't exhaust the stack. */
+			cJSON *last=c->child;
+			while (last->next) last=last->next;
+			last->next=c->next;
+			c->next=c->child;
+		}
 		next=c->next;
-		if (!(c->type&cJSON_IsReference) && c->child) cJSON_Delete(c->child);
-		if (!(c->type&cJSON_IsReference) && c->valuestring) cJSON_free(c->valuestring);
-		if (c->string) cJSON_free(c->string);
-		cJSON_free(c);
+		if (!(c->type&cJSON_IsReference) && c->valuestring) hooks->free_fn(c->valuestring);
+		if (c->string) hooks->free_fn(c->string);
+		hooks->free_fn(c);
 		c=next;
 	}
 }
 
+void cJSON_Delete(cJSON *c)
+{
+	cJSON_Hooks hooks;
+	hooks.malloc_fn=cJSON_malloc;
+	hooks.free_fn=cJSON_free;
+	cJSON_DeleteWithHooks(c,&hooks);
+}
+
 /* Parse the input text to generate a number, and populate the result into item. */
 static const char *parse_number(cJSON *item,const char *num)
 {
@@ -137,33 +171,56 @@ static char *print_number(cJSON *item)
 	return str;
 }
 
-static unsigned parse_hex4(const char *str)
+/* Parse 4 hex digits; returns 0 if any of them isn't one. */
+static int parse_hex4(const char *str,unsigned *h)
+{
+	int i;*h=0;
+	for (i=0;i<4;i++,str++)
+	{
+		*h=*h<<4;
+		if (*str>='0' && *str<='9') *h+=(*str)-'0'; else if (*str>='A' && *str<='F') *h+=10+(*str)-'A'; else if (*str>='a' && *str<='f') *h+=10+(*str)-'a'; else return 0;
+	}
+	return 1;
+}
+
+/* Record a parse failure in the context. */
+static const char *parse_error(cJSON_ParseContext *ctx,const char *at,int code)
+{
+	ctx->error=at;
+	ctx->error_code=code;
+	return 0;
+}
+
+const char *cJSON_GetErrorString(int error_code)
 {
-	unsigned h=0;
-	if (*str>='0' && *str<='9') h+=(*str)-'0'; else if (*str>='A' && *str<='F') h+=10+(*str)-'A'; else if (*str>='a' && *str<='f') h+=10+(*str)-'a'; else return 0;
-	h=h<<4;str++;
-	if (*str>='0' && *str<='9') h+=(*str)-'0'; else if (*str>='A' && *str<='F') h+=10+(*str)-'A'; else if (*str>='a' && *str<='f') h+=10+(*str)-'a'; else return 0;
-	h=h<<4;str++;
-	if (*str>='0' && *str<='9') h+=(*str)-'0'; else if (*str>='A' && *str<='F') h+=10+(*str)-'A'; else if (*str>='a' && *str<='f') h+=10+(*str)-'a'; else return 0;
-	h=h<<4;str++;
-	if (*str>='0' && *str<='9') h+=(*str)-'0'; else if (*str>='A' && *str<='F') h+=10+(*str)-'A'; else if (*str>='a' && *str<='f') h+=10+(*str)-'a'; else return 0;
-	return h;
+	switch (error_code)
+	{
+		case cJSON_ErrorNone:	return "no error";
+		case cJSON_ErrorSyntax:	return "syntax error";
+		case cJSON_ErrorMemory:	return "out of memory";
+		case cJSON_ErrorDepth:	return "maximum nesting depth exceeded";
+		case cJSON_ErrorSize:	return "maximum document size exceeded";
+		case cJSON_ErrorNodes:	return "maximum node count exceeded";
+	}
+	return "unknown error";
 }
 
 /* Parse the input text into an unescaped cstring, and populate item. */
 static const unsigned char firstByteMark[7] = { 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC };
-static const char *parse_string(cJSON *item,const char *str)
+static const char *parse_string(cJSON_ParseContext *ctx,cJSON *item,const char *str)
 {
-	const char *ptr=str+1;char *ptr2;char *out;int len=0;unsigned uc,uc2;
-	if (*str!='\"') {ep=str;return 0;}	/* not a string! */
+	const char *ptr=str+1,*end;char *ptr2;char *out;int len=0;unsigned uc,uc2;
+	if (*str!='\"') return parse_error(ctx,str,cJSON_ErrorSyntax);	/* not a string! */
 	
-	while (*ptr!='\"' && *ptr && ++len) if (*ptr++ == '\\') ptr++;	/* Skip escaped quotes. */
+	while (*ptr!='\"' && *ptr && ++len) if (*ptr++ == '\\' && *ptr) ptr++;	/* Skip escaped quotes. */
+	if (*ptr!='\"') return parse_error(ctx,str,cJSON_ErrorSyntax);	/* unterminated. */
+	end=ptr;
 	
-	out=(char*)cJSON_malloc(len+1);	/* This is how long we need for the string, roughly. */
-	if (!out) return 0;
+	out=(char*)ctx->hooks.malloc_fn(len+1);	/* This is how long we need for the string, roughly. */
+	if (!out) return parse_error(ctx,str,cJSON_ErrorMemory);
 	
 	ptr=str+1;ptr2=out;
-	while (*ptr!='\"' && *ptr)
+	while (ptr<end)
 	{
 		if (*ptr!='\\') *ptr2++=*ptr++;
 		else
@@ -177,14 +234,17 @@ static const char *parse_string(cJSON *item,const char *str)
 				case 'r': *ptr2++='\r';	break;
 				case 't': *ptr2++='\t';	break;
 				case 'u':	 /* transcode utf16 to utf8. */
-					uc=parse_hex4(ptr+1);ptr+=4;	/* get the unicode char. */
+					if (end-ptr<5) {ctx->hooks.free_fn(out);return parse_error(ctx,ptr,cJSON_ErrorSyntax);}	/* truncated escape. */
+					if (!parse_hex4(ptr+1,&uc)) {ctx->hooks.free_fn(out);return parse_error(ctx,ptr,cJSON_ErrorSyntax);}	/* not hex; skipping 4 would desync from the length pass. */
+					ptr+=4;
 
 					if ((uc>=0xDC00 && uc<=0xDFFF) || uc==0)	break;	/* check for invalid.	*/
 
 					if (uc>=0xD800 && uc<=0xDBFF)	/* UTF16 surrogate pairs.	*/
 					{
-						if (ptr[1]!='\\' || ptr[2]!='u')	break;	/* missing second-half of surrogate.	*/
-						uc2=parse_hex4(ptr+3);ptr+=6;
+						if (end-ptr<7 || ptr[1]!='\\' || ptr[2]!='u')	break;	/* missing second-half of surrogate.	*/
+						if (!parse_hex4(ptr+3,&uc2)) {ctx->hooks.free_fn(out);return parse_error(ctx,ptr,cJSON_ErrorSyntax);}
+						ptr+=6;
 						if (uc2<0xDC00 || uc2>0xDFFF)		break;	/* invalid second-half of surrogate.	*/
 						uc=0x10000 + (((uc&0x3FF)<<10) | (uc2&0x3FF));
 					}
@@ -250,52 +310,155 @@ static char *print_string_ptr(const char *str)
 static char *print_string(cJSON *item)	{return print_string_ptr(item->valuestring);}
 
 /* Predeclare these prototypes. */
-static const char *parse_value(cJSON *item,const char *value);
+static const char *parse_value(cJSON_ParseContext *ctx,cJSON *item,const char *value);
 static char *print_value(cJSON *item,int depth,int fmt);
-static const char *parse_array(cJSON *item,const char *value);
 static char *print_array(cJSON *item,int depth,int fmt);
-static const char *parse_object(cJSON *item,const char *value);
 static char *print_object(cJSON *item,int depth,int fmt);
 
 /* Utility to jump whitespace and cr/lf */
 static const char *skip(const char *in) {while (in && *in && (unsigned char)*in<=32) in++; return in;}
 
 /* Parse an object - create a new root, and populate. */
-cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_end,int require_null_terminated)
+cJSON *cJSON_ParseWithContext(cJSON_ParseContext *ctx,const char *value,const char **return_parse_end,int require_null_terminated)
 {
 	const char *end=0;
-	cJSON *c=cJSON_New_Item();
-	ep=0;
-	if (!c) return 0;       /* memory fail */
+	cJSON *c;
+	ctx->error=0;
+	ctx->error_code=cJSON_ErrorNone;
+	if (!value) {parse_error(ctx,value,cJSON_ErrorSyntax);return 0;}	/* nothing to parse. */
+	if (ctx->max_size && strnlen(value,ctx->max_size+1)>ctx->max_size) {parse_error(ctx,value+ctx->max_size,cJSON_ErrorSize);return 0;}	/* refuse before allocating anything. */
 
-	end=parse_value(c,skip(value));
-	if (!end)	{cJSON_Delete(c);return 0;}	/* parse failure. ep is set. */
+	c=cJSON_New_Item_With(&ctx->hooks);
+	if (!c) {parse_error(ctx,value,cJSON_ErrorMemory);return 0;}
+
+	end=parse_value(ctx,c,skip(value));
+	if (!end)	{cJSON_DeleteWithHooks(c,&ctx->hooks);return 0;}	/* parse failure. ctx->error is set. */
 
 	/* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-	if (require_null_terminated) {end=skip(end);if (*end) {cJSON_Delete(c);ep=end;return 0;}}
+	if (require_null_terminated) {end=skip(end);if (*end) {cJSON_DeleteWithHooks(c,&ctx->hooks);parse_error(ctx,end,cJSON_ErrorSyntax);return 0;}}
 	if (return_parse_end) *return_parse_end=end;
 	return c;
 }
-/* Default options for cJSON_Parse */
+/* Legacy entry points - a private context per call, with the error published for cJSON_GetErrorPtr(). */
+cJSON *cJSON_ParseWithOpts(const char *value,const char **return_parse_end,int require_null_terminated)
+{
+	cJSON_ParseContext ctx;
+	cJSON *c;
+	cJSON_InitParseContext(&ctx);
+	c=cJSON_ParseWithContext(&ctx,value,return_parse_end,require_null_terminated);
+	ep=ctx.error;
+	return c;
+}
 cJSON *cJSON_Parse(const char *value) {return cJSON_ParseWithOpts(value,0,0);}
 
 /* Render a cJSON item/entity/structure to text. */
 char *cJSON_Print(cJSON *item)				{return print_value(item,0,1);}
 char *cJSON_PrintUnformatted(cJSON *item)	{return print_value(item,0,0);}
 
-/* Parser core - when encountering text, process appropriately. */
-static const char *parse_value(cJSON *item,const char *value)
+/* Parse a scalar into item. */
+static const char *parse_scalar(cJSON_ParseContext *ctx,cJSON *item,const char *value)
 {
-	if (!value)						return 0;	/* Fail on null. */
 	if (!strncmp(value,"null",4))	{ item->type=cJSON_NULL;  return value+4; }
 	if (!strncmp(value,"false",5))	{ item->type=cJSON_False; return value+5; }
 	if (!strncmp(value,"true",4))	{ item->type=cJSON_True; item->valueint=1;	return value+4; }
-	if (*value=='\"')				{ return parse_string(item,value); }
+	if (*value=='\"')				{ return parse_string(ctx,item,value); }
 	if (*value=='-' || (*value>='0' && *value<='9'))	{ return parse_number(item,value); }
-	if (*value=='[')				{ return parse_array(item,value); }
-	if (*value=='{')				{ return parse_object(item,value); }
 
-	ep=value;return 0;	/* failure. */
+	return parse_error(ctx,value,cJSON_ErrorSyntax);	/* failure. */
+}
+
+/* Allocate the next node of the tree, enforcing the node limit. */
+static cJSON *parse_new_item(cJSON_ParseContext *ctx,int *nodes,const char *value)
+{
+	cJSON *item;
+	if (ctx->max_nodes && ++*nodes>ctx->max_nodes) {parse_error(ctx,value,cJSON_ErrorNodes);return 0;}
+	if (!(item=cJSON_New_Item_With(&ctx->hooks))) parse_error(ctx,value,cJSON_ErrorMemory);
+	return item;
+}
+
+/* Parse an object member name and the following colon into item. */
+static const char *parse_key(cJSON_ParseContext *ctx,cJSON *item,const char *value)
+{
+	value=skip(parse_string(ctx,item,skip(value)));
+	if (!value) return 0;
+	item->string=item->valuestring;item->valuestring=0;
+	if (*value!=':') return parse_error(ctx,value,cJSON_ErrorSyntax);	/* fail! */
+	return value+1;
+}
+
+/* Stack of the arrays/objects enclosing the value being parsed. */
+typedef struct {cJSON **items;int count,capacity;} parse_stack;
+
+static int parse_push(cJSON_ParseContext *ctx,parse_stack *stack,cJSON *item)
+{
+	if (stack->count==stack->capacity)
+	{
+		int capacity=stack->capacity?stack->capacity*2:16;
+		cJSON **items=(cJSON**)ctx->hooks.malloc_fn(capacity*sizeof(cJSON*));
+		if (!items) return 0;
+		if (stack->count) memcpy(items,stack->items,stack->count*sizeof(cJSON*));
+		if (stack->items) ctx->hooks.free_fn(stack->items);
+		stack->items=items;stack->capacity=capacity;
+	}
+	stack->items[stack->count++]=item;
+	return 1;
+}
+
+/* Parser core - iterative, so the nesting depth is bounded by max_depth rather than by the call stack. */
+static const char *parse_value(cJSON_ParseContext *ctx,cJSON *item,const char *value)
+{
+	parse_stack stack={0,0,0};
+	int nodes=1;	/* the root */
+	cJSON *parent;
+
+	while (1)
+	{
+		/* item is a fresh node waiting for its value. */
+		value=skip(value);
+		if (*value=='[' || *value=='{')
+		{
+			char close=(*value=='[')?']':'}';
+			item->type=(*value=='[')?cJSON_Array:cJSON_Object;
+			value=skip(value+1);
+			if (*value!=close)
+			{
+				if (ctx->max_depth && stack.count>=ctx->max_depth) {parse_error(ctx,value,cJSON_ErrorDepth);break;}	/* nested too deeply. */
+				if (!parse_push(ctx,&stack,item)) {parse_error(ctx,value,cJSON_ErrorMemory);break;}
+				if (!(item->child=parse_new_item(ctx,&nodes,value))) break;
+				item=item->child;
+				if (close=='}' && !(value=parse_key(ctx,item,value))) break;
+				continue;
+			}
+			value++;	/* empty array/object. */
+		}
+		else if (!(value=parse_scalar(ctx,item,value))) break;
+
+		/* item is complete - move on to its next sibling, closing any containers that end here. */
+		while (stack.count)
+		{
+			parent=stack.items[stack.count-1];
+			value=skip(value);
+			if (*value==',')
+			{
+				cJSON *new_item=parse_new_item(ctx,&nodes,value);
+				if (!new_item) break;
+				item->next=new_item;new_item->prev=item;item=new_item;
+				value++;
+				if (parent->type==cJSON_Object) value=parse_key(ctx,item,value);
+				break;
+			}
+			if (*value!=((parent->type==cJSON_Array)?']':'}')) {parse_error(ctx,value,cJSON_ErrorSyntax);break;}	/* malformed. */
+			item=parent;
+			value++;
+			stack.count--;
+		}
+
+		if (ctx->error_code!=cJSON_ErrorNone) break;
+		if (!stack.count) break;	/* the root is complete. */
+	}
+
+	if (stack.items) ctx->hooks.free_fn(stack.items);
+	return (ctx->error_code==cJSON_ErrorNone)?value:0;
 }
 
 /* Render a value to text. */
@@ -316,34 +479,6 @@ static char *print_value(cJSON *item,int depth,int fmt)
 	return out;
 }
 
-/* Build an array from input text. */
-static const char *parse_array(cJSON *item,const char *value)
-{
-	cJSON *child;
-	if (*value!='[')	{ep=value;return 0;}	/* not an array! */
-
-	item->type=cJSON_Array;
-	value=skip(value+1);
-	if (*value==']') return value+1;	/* empty array. */
-
-	item->child=child=cJSON_New_Item();
-	if (!item->child) return 0;		 /* memory fail */
-	value=skip(parse_value(child,skip(value)));	/* skip any spacing, get the value. */
-	if (!value) return 0;
-
-	while (*value==',')
-	{
-		cJSON *new_item;
-		if (!(new_item=cJSON_New_Item())) return 0; 	/* memory fail */
-		child->next=new_item;new_item->prev=child;child=new_item;
-		value=skip(parse_value(child,skip(value+1)));
-		if (!value) return 0;	/* memory fail */
-	}
-
-	if (*value==']') return value+1;	/* end of array */
-	ep=value;return 0;	/* malformed. */
-}
-
 /* Render an array to text */
 static char *print_array(cJSON *item,int depth,int fmt)
 {
@@ -402,42 +537,6 @@ static char *print_array(cJSON *item,int depth,int fmt)
 	return out;	
 }
 
-/* Build an object from the text. */
-static const char *parse_object(cJSON *item,const char *value)
-{
-	cJSON *child;
-	if (*value!='{')	{ep=value;return 0;}	/* not an object! */
-	
-	item->type=cJSON_Object;
-	value=skip(value+1);
-	if (*value=='}') return value+1;	/* empty array. */
-	
-	item->child=child=cJSON_New_Item();
-	if (!item->child) return 0;
-	value=skip(parse_string(child,skip(value)));
-	if (!value) return 0;
-	child->string=child->valuestring;child->valuestring=0;
-	if (*value!=':') {ep=value;return 0;}	/* fail! */
-	value=skip(parse_value(child,skip(value+1)));	/* skip any spacing, get the value. */
-	if (!value) return 0;
-	
-	while (*value==',')
-	{
-		cJSON *new_item;
-		if (!(new_item=cJSON_New_Item()))	return 0; /* memory fail */
-		child->next=new_item;new_item->prev=child;child=new_item;
-		value=skip(parse_string(child,skip(value+1)));
-		if (!value) return 0;
-		child->string=child->valuestring;child->valuestring=0;
-		if (*value!=':') {ep=value;return 0;}	/* fail! */
-		value=skip(parse_value(child,skip(value+1)));	/* skip any spacing, get the value. */
-		if (!value) return 0;
-	}
-	
-	if (*value=='}') return value+1;	/* end of array */
-	ep=value;return 0;	/* malformed. */
-}
-
 /* Render an object to text. */
 static char *print_object(cJSON *item,int depth,int fmt)
 {
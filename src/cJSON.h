@@ -58,9 +58,41 @@ typedef struct cJSON_Hooks {
       void (*free_fn)(void *ptr);
 } cJSON_Hooks;
 
-/* Supply malloc, realloc and free functions to cJSON */
+/* Supply malloc, realloc and free functions to cJSON. Not thread-safe; call before any parsing starts. */
 extern void cJSON_InitHooks(cJSON_Hooks* hooks);
 
+/* Default parse limits. */
+#define cJSON_DefaultMaxDepth 512
+#define cJSON_DefaultMaxSize (64*1024*1024)
+#define cJSON_DefaultMaxNodes 4000000
+
+/* Parse error codes. */
+#define cJSON_ErrorNone 0
+#define cJSON_ErrorSyntax 1
+#define cJSON_ErrorMemory 2
+#define cJSON_ErrorDepth 3
+#define cJSON_ErrorSize 4
+#define cJSON_ErrorNodes 5
+
+/* Parse context: carries all state for one parse, so parses on different threads are independent. */
+typedef struct cJSON_ParseContext {
+	cJSON_Hooks hooks;			/* Allocator for the parsed tree. Release the tree with cJSON_DeleteWithHooks(). */
+	int max_depth;				/* Maximum nesting of arrays/objects; 0 for no limit. */
+	size_t max_size;			/* Maximum length of the input text in bytes; 0 for no limit. */
+	int max_nodes;				/* Maximum number of items in the parsed tree; 0 for no limit. */
+	const char *error;			/* Position of the parse error; 0 when the parse succeeds. */
+	int error_code;				/* One of the cJSON_Error* codes. */
+} cJSON_ParseContext;
+
+/* Fill a context with the current hooks and default limits. */
+extern void cJSON_InitParseContext(cJSON_ParseContext *context);
+/* As cJSON_ParseWithOpts, but reports errors through the context instead of cJSON_GetErrorPtr(). */
+extern cJSON *cJSON_ParseWithContext(cJSON_ParseContext *context,const char *value,const char **return_parse_end,int require_null_terminated);
+/* Describe a cJSON_Error* code. */
+extern const char *cJSON_GetErrorString(int error_code);
+/* Delete a cJSON entity that was allocated with the specified hooks. */
+extern void cJSON_DeleteWithHooks(cJSON *c,const cJSON_Hooks *hooks);
+
 
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. Call cJSON_Delete when finished. */
 extern cJSON *cJSON_Parse(const char *value);
@@ -78,7 +110,7 @@ extern cJSON *cJSON_GetArrayItem(cJSON *array,int item);
 /* Get item "string" from object. Case insensitive. */
 extern cJSON *cJSON_GetObjectItem(cJSON *object,const char *string);
 
-/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. */
+/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when cJSON_Parse() returns 0. 0 when cJSON_Parse() succeeds. Tracked per thread. */
 extern const char *cJSON_GetErrorPtr(void);
 	
 /* These calls create a cJSON item of the appropriate type. */
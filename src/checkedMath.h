@@ -0,0 +1,52 @@
+// File:  checkedMath.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Overflow-checked arithmetic for download and size counters.
+
+#ifndef CHECKED_MATH_H_
+#define CHECKED_MATH_H_
+
+// Standard C++ headers
+#include <cstdint>
+#include <limits>
+
+// Adds value to sum.  On overflow the sum saturates and false is returned.
+inline bool CheckedAdd(uint64_t& sum, const uint64_t& value)
+{
+	if (value > std::numeric_limits<uint64_t>::max() - sum)
+	{
+		sum = std::numeric_limits<uint64_t>::max();
+		return false;
+	}
+
+	sum += value;
+	return true;
+}
+
+inline bool CheckedAdd(int64_t& sum, const int64_t& value)
+{
+	if (value > 0 && sum > std::numeric_limits<int64_t>::max() - value)
+	{
+		sum = std::numeric_limits<int64_t>::max();
+		return false;
+	}
+	else if (value < 0 && sum < std::numeric_limits<int64_t>::min() - value)
+	{
+		sum = std::numeric_limits<int64_t>::min();
+		return false;
+	}
+
+	sum += value;
+	return true;
+}
+
+// Signed a - b, saturating at the limits of int64_t
+inline int64_t CheckedDifference(const uint64_t& a, const uint64_t& b)
+{
+	const uint64_t limit(static_cast<uint64_t>(std::numeric_limits<int64_t>::max()));
+	if (a >= b)
+		return a - b > limit ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(a - b);
+	return b - a > limit ? std::numeric_limits<int64_t>::min() : -static_cast<int64_t>(b - a);
+}
+
+#endif// CHECKED_MATH_H_
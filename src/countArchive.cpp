@@ -0,0 +1,446 @@
+// File:  countArchive.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Compressed long-term archive of download history.  Samples from the
+//        history log are grouped into blocks, each holding the count series
+//        of every asset sampled in a span of time, stored as delta-of-delta
+//        varint columns.  Regular polling of slowly growing counts makes most
+//        points cost a byte or two.
+
+// Local headers
+#include "countArchive.h"
+#include "countHistory.h"
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <filesystem>
+#include <map>
+#include <tuple>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+
+const char CountArchive::magic[8] = { 'G', 'H', 'A', 'R', 'C', 'H', '\r', '\n' };
+
+static void WriteVarint(std::string& buffer, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back(static_cast<char>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+static bool ReadVarint(const unsigned char*& p, const unsigned char* end, uint64_t& value)
+{
+	// Most values fit in one byte
+	if (p != end && *p < 0x80)
+	{
+		value = *p++;
+		return true;
+	}
+
+	value = 0;
+	for (unsigned int shift = 0; shift < 64 && p != end; shift += 7)
+	{
+		const unsigned char byte(*p++);
+		value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+		if (byte < 0x80)
+			return true;
+	}
+	return false;
+}
+
+// Differences are taken mod 2^64 so they never overflow; zigzag encoding then
+// keeps small negative values small
+static uint64_t ZigZag(const uint64_t& difference)
+{
+	return (difference << 1) ^ (0 - (difference >> 63));
+}
+
+static uint64_t UnZigZag(const uint64_t& value)
+{
+	return (value >> 1) ^ (0 - (value & 1));
+}
+
+static void WriteName(std::string& buffer, const std::string_view& name, const std::string_view& previous)
+{
+	size_t shared(0);
+	while (shared < name.length() && shared < previous.length() && name[shared] == previous[shared])
+		++shared;
+
+	WriteVarint(buffer, shared);
+	WriteVarint(buffer, name.length() - shared);
+	buffer.append(name.substr(shared));
+}
+
+static bool ReadName(const unsigned char*& p, const unsigned char* end, std::string& name)
+{
+	uint64_t shared, length;
+	if (!ReadVarint(p, end, shared) || !ReadVarint(p, end, length) ||
+		shared > name.length() || length > static_cast<uint64_t>(end - p))
+		return false;
+
+	name.resize(static_cast<size_t>(shared));
+	name.append(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+	p += length;
+	return true;
+}
+
+bool CountArchive::Open(const std::string& fileName)
+{
+	Close();
+	if (!file.Open(fileName))
+		return false;
+
+	FileHeader header;
+	if (file.GetSize() < sizeof(header))
+		return false;
+
+	memcpy(&header, file.GetData(), sizeof(header));
+	if (memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+	{
+		std::cerr << "'" << fileName << "' is not a download history archive (or has an unsupported version)\n";
+		Close();
+		return false;
+	}
+
+	Rewind();
+	return true;
+}
+
+void CountArchive::Close()
+{
+	file.Close();
+	position = 0;
+	damaged = false;
+	next = nullptr;
+	blockEnd = nullptr;
+	seriesRemaining = 0;
+}
+
+void CountArchive::Rewind()
+{
+	position = sizeof(FileHeader);
+	damaged = false;
+	next = nullptr;
+	blockEnd = nullptr;
+	seriesRemaining = 0;
+}
+
+bool CountArchive::ReadBlockHeader(const size_t& offset, BlockHeader& header) const
+{
+	if (file.GetSize() - offset < sizeof(header))
+		return false;
+
+	memcpy(&header, file.GetData() + offset, sizeof(header));
+	return header.marker == blockMarker && header.payloadSize <= file.GetSize() - offset - sizeof(header) &&
+		header.minTime <= header.maxTime;
+}
+
+bool CountArchive::NextBlockHeader(BlockHeader& header, size_t& payloadOffset)
+{
+	while (position < file.GetSize())
+	{
+		if (ReadBlockHeader(position, header))
+		{
+			payloadOffset = position + sizeof(header);
+			position = payloadOffset + header.payloadSize;
+			return true;
+		}
+
+		// Resynchronize on the next block marker
+		damaged = true;
+		const char* const data(file.GetData());
+		for (++position; position + sizeof(blockMarker) <= file.GetSize(); ++position)
+		{
+			uint32_t marker;
+			memcpy(&marker, data + position, sizeof(marker));
+			if (marker == blockMarker)
+				break;
+		}
+
+		if (position + sizeof(blockMarker) > file.GetSize())
+			position = file.GetSize();
+	}
+
+	return false;
+}
+
+bool CountArchive::NextBlock(const int64_t& begin, const int64_t& end)
+{
+	next = nullptr;
+	blockEnd = nullptr;
+	seriesRemaining = 0;
+
+	BlockHeader header;
+	size_t payloadOffset;
+	while (NextBlockHeader(header, payloadOffset))
+	{
+		if (header.maxTime < begin || header.minTime > end)
+			continue;
+
+		const char* const payload(file.GetData() + payloadOffset);
+		if (CountHistory::Checksum(payload, header.payloadSize) != header.checksum)
+		{
+			damaged = true;
+			continue;
+		}
+
+		next = reinterpret_cast<const unsigned char*>(payload);
+		blockEnd = next + header.payloadSize;
+		seriesRemaining = header.seriesCount;
+		blockMinTime = header.minTime;
+		blockMaxTime = header.maxTime;
+		for (auto& name : previousNames)
+			name.clear();
+
+		// The count is also stored in the payload; they must agree
+		uint64_t seriesCount;
+		if (!ReadVarint(next, blockEnd, seriesCount) || seriesCount != seriesRemaining)
+		{
+			damaged = true;
+			seriesRemaining = 0;
+			continue;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+bool CountArchive::NextSeries(Series& series)
+{
+	if (seriesRemaining == 0)
+		return false;
+
+	if (!DecodeSeries(series))
+	{
+		damaged = true;
+		seriesRemaining = 0;
+		return false;
+	}
+
+	--seriesRemaining;
+	return true;
+}
+
+bool CountArchive::DecodeSeries(Series& series)
+{
+	for (auto& name : previousNames)
+	{
+		if (!ReadName(next, blockEnd, name))
+			return false;
+	}
+
+	series.repo = previousNames[0];
+	series.tag = previousNames[1];
+	series.asset = previousNames[2];
+
+	// Every point takes at least two bytes
+	uint64_t pointCount;
+	if (!ReadVarint(next, blockEnd, pointCount) || pointCount == 0 ||
+		pointCount > static_cast<uint64_t>(blockEnd - next) / 2)
+		return false;
+	series.points.resize(static_cast<size_t>(pointCount));
+
+	uint64_t value, delta(0);
+	if (!ReadVarint(next, blockEnd, value))
+		return false;
+	uint64_t time(static_cast<uint64_t>(blockMinTime) + value);
+	series.points[0].time = static_cast<int64_t>(time);
+	for (size_t i = 1; i < series.points.size(); ++i)
+	{
+		if (!ReadVarint(next, blockEnd, value))
+			return false;
+		delta += UnZigZag(value);
+		time += delta;
+		series.points[i].time = static_cast<int64_t>(time);
+	}
+
+	uint64_t count;
+	if (!ReadVarint(next, blockEnd, count))
+		return false;
+	delta = 0;
+	series.points[0].count = count;
+	for (size_t i = 1; i < series.points.size(); ++i)
+	{
+		if (!ReadVarint(next, blockEnd, value))
+			return false;
+		delta += UnZigZag(value);
+		count += delta;
+		series.points[i].count = count;
+	}
+
+	uint64_t runCount;
+	if (!ReadVarint(next, blockEnd, runCount))
+		return false;
+
+	size_t point(0);
+	for (uint64_t i = 0; i < runCount; ++i)
+	{
+		uint64_t flags, length;
+		if (!ReadVarint(next, blockEnd, flags) || !ReadVarint(next, blockEnd, length) ||
+			length > series.points.size() - point)
+			return false;
+
+		for (const size_t runEnd(point + static_cast<size_t>(length)); point < runEnd; ++point)
+			series.points[point].flags = static_cast<uint32_t>(flags);
+	}
+
+	return point == series.points.size();
+}
+
+// Key is (repo, tag, asset), so the series come out sorted for prefix sharing
+typedef std::map<std::tuple<std::string_view, std::string_view, std::string_view>,
+	std::vector<CountArchive::Point>> SeriesMap;
+
+static void WriteSeriesColumns(std::string& buffer, const std::vector<CountArchive::Point>& points, const int64_t& minTime)
+{
+	WriteVarint(buffer, points.size());
+
+	uint64_t previousDelta(0);
+	WriteVarint(buffer, static_cast<uint64_t>(points[0].time) - static_cast<uint64_t>(minTime));
+	for (size_t i = 1; i < points.size(); ++i)
+	{
+		const uint64_t delta(static_cast<uint64_t>(points[i].time) - static_cast<uint64_t>(points[i - 1].time));
+		WriteVarint(buffer, ZigZag(delta - previousDelta));
+		previousDelta = delta;
+	}
+
+	previousDelta = 0;
+	WriteVarint(buffer, points[0].count);
+	for (size_t i = 1; i < points.size(); ++i)
+	{
+		const uint64_t delta(points[i].count - points[i - 1].count);
+		WriteVarint(buffer, ZigZag(delta - previousDelta));
+		previousDelta = delta;
+	}
+
+	size_t runCount(1);
+	for (size_t i = 1; i < points.size(); ++i)
+	{
+		if (points[i].flags != points[i - 1].flags)
+			++runCount;
+	}
+
+	WriteVarint(buffer, runCount);
+	size_t runStart(0);
+	for (size_t i = 1; i <= points.size(); ++i)
+	{
+		if (i == points.size() || points[i].flags != points[runStart].flags)
+		{
+			WriteVarint(buffer, points[runStart].flags);
+			WriteVarint(buffer, i - runStart);
+			runStart = i;
+		}
+	}
+}
+
+bool CountArchive::Append(const std::string& fileName, const std::string& historyFileName, const size_t& minimumSamples)
+{
+	// Appends to the log wait until its batches have moved to the archive
+	const FileLock lock(historyFileName);
+	if (!lock.IsLocked())
+		return false;
+
+	CountHistory history;
+	if (!history.Open(historyFileName))
+	{
+		std::error_code error;
+		return !std::filesystem::exists(historyFileName, error);
+	}
+
+	// Count first, so nothing is decoded or written for a small backlog
+	int64_t time;
+	std::vector<CountHistory::Sample> samples;
+	size_t newSamples(0);
+	while (history.NextBatch(time, samples))
+		newSamples += samples.size();
+
+	if (newSamples == 0 || newSamples < minimumSamples)
+		return true;
+
+	std::string buffer;
+	std::error_code error;
+	if (!std::filesystem::exists(fileName, error))
+	{
+		FileHeader header;
+		memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.reserved = 0;
+		buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+	}
+
+	SeriesMap series;
+	size_t blockSamples(0);
+	int64_t minTime(0), maxTime(0);
+	const auto writeBlock([&buffer, &series, &blockSamples, &minTime, &maxTime]()
+	{
+		// Batches from concurrent pollers can be slightly out of order
+		for (auto& s : series)
+			std::stable_sort(s.second.begin(), s.second.end(), [](const Point& a, const Point& b)
+			{
+				return a.time < b.time;
+			});
+
+		const size_t headerOffset(buffer.size());
+		buffer.resize(headerOffset + sizeof(BlockHeader));
+
+		WriteVarint(buffer, series.size());
+		std::tuple<std::string_view, std::string_view, std::string_view> previous;
+		for (const auto& s : series)
+		{
+			WriteName(buffer, std::get<0>(s.first), std::get<0>(previous));
+			WriteName(buffer, std::get<1>(s.first), std::get<1>(previous));
+			WriteName(buffer, std::get<2>(s.first), std::get<2>(previous));
+			WriteSeriesColumns(buffer, s.second, minTime);
+			previous = s.first;
+		}
+
+		const size_t payloadOffset(headerOffset + sizeof(BlockHeader));
+		BlockHeader header;
+		header.marker = blockMarker;
+		header.payloadSize = static_cast<uint32_t>(buffer.size() - payloadOffset);
+		header.minTime = minTime;
+		header.maxTime = maxTime;
+		header.seriesCount = static_cast<uint32_t>(series.size());
+		header.checksum = CountHistory::Checksum(buffer.data() + payloadOffset, header.payloadSize);
+		memcpy(&buffer[headerOffset], &header, sizeof(header));
+
+		series.clear();
+		blockSamples = 0;
+	});
+
+	history.Rewind();
+	while (history.NextBatch(time, samples))
+	{
+		if (samples.empty())
+			continue;
+
+		if (blockSamples == 0)
+			minTime = maxTime = time;
+		minTime = std::min(minTime, time);
+		maxTime = std::max(maxTime, time);
+
+		for (const auto& sample : samples)
+			series[std::make_tuple(sample.repo, sample.tag, sample.asset)].push_back({ time, sample.count, sample.flags });
+
+		// Blocks end on batch boundaries; a single batch is far smaller than
+		// the payload size limit
+		blockSamples += samples.size();
+		if (blockSamples >= maxBlockSamples)
+			writeBlock();
+	}
+
+	if (blockSamples > 0)
+		writeBlock();
+
+	// Everything in the log is now in the archive.  (A crash before the log
+	// is emptied leaves the batches in both, and readers drop the repeats.)
+	history.Close();
+	return AppendDurably(fileName, buffer.data(), buffer.size()) && CountHistory::Reset(historyFileName);
+}
@@ -0,0 +1,124 @@
+// File:  countArchive.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Compressed long-term archive of download history.  Samples from the
+//        history log are grouped into blocks, each holding the count series
+//        of every asset sampled in a span of time, stored as delta-of-delta
+//        varint columns.  Regular polling of slowly growing counts makes most
+//        points cost a byte or two.
+
+#ifndef COUNT_ARCHIVE_H_
+#define COUNT_ARCHIVE_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+// Local headers
+#include "mappedFile.h"
+
+// File layout (host byte order for the headers):
+//   FileHeader
+//   Blocks, each a BlockHeader followed by payloadSize bytes of:
+//     varint seriesCount
+//     seriesCount series, sorted by (repo, tag, asset), each:
+//       repo, tag and asset, each as varint shared prefix length (with the
+//         previous series), varint suffix length and the suffix text
+//       varint pointCount (at least one)
+//       times:  varint (first - minTime), then zigzag delta-of-deltas
+//       counts:  varint first, then zigzag delta-of-deltas (mod 2^64)
+//       flags:  varint runCount, then runCount (varint flags, varint length)
+// Blocks are only appended, and each is checksummed.  A block's span of time
+// can overlap earlier blocks' (batches aren't always logged in time order).
+class CountArchive
+{
+public:
+	static constexpr uint32_t version = 1;
+
+	struct Point
+	{
+		int64_t time;
+		uint64_t count;
+		uint32_t flags;
+	};
+
+	struct Series
+	{
+		std::string repo;
+		std::string tag;
+		std::string asset;
+		std::vector<Point> points;
+	};
+
+	// A missing file fails quietly
+	bool Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// Advances to the next block spanning any part of [begin, end], skipping
+	// the others without reading their payload.  Returns false at the end of
+	// the archive.
+	bool NextBlock(const int64_t& begin = std::numeric_limits<int64_t>::min(),
+		const int64_t& end = std::numeric_limits<int64_t>::max());
+	int64_t GetBlockMinTime() const { return blockMinTime; }
+	int64_t GetBlockMaxTime() const { return blockMaxTime; }
+
+	// Decodes the next series of the current block, reusing the storage in
+	// series.  Returns false at the end of the block.
+	bool NextSeries(Series& series);
+	void Rewind();
+
+	// True if a block failed its checksum or couldn't be decoded
+	bool HasDamage() const { return damaged; }
+
+	// Moves the history log's batches into the archive once there are at
+	// least minimumSamples of them (so blocks aren't too small to compress
+	// well), leaving the log empty.  Holds the log's FileLock throughout.
+	static bool Append(const std::string& fileName, const std::string& historyFileName,
+		const size_t& minimumSamples = defaultMinimumSamples);
+
+	static constexpr size_t defaultMinimumSamples = 4096;
+	static constexpr size_t maxBlockSamples = 65536;
+
+private:
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+	};
+
+	struct BlockHeader
+	{
+		uint32_t marker;
+		uint32_t payloadSize;
+		int64_t minTime;
+		int64_t maxTime;
+		uint32_t seriesCount;
+		uint32_t checksum;// Of the payload
+	};
+
+	static const char magic[8];
+	static constexpr uint32_t blockMarker = 0x4B4C4241;// "ABLK"
+
+	MappedFile file;
+	size_t position = 0;// Of the next block header
+	bool damaged = false;
+
+	// Decoding state of the current block
+	const unsigned char* next = nullptr;
+	const unsigned char* blockEnd = nullptr;
+	uint32_t seriesRemaining = 0;
+	int64_t blockMinTime = 0;
+	int64_t blockMaxTime = 0;
+	std::string previousNames[3];// Repo, tag and asset of the last series
+
+	bool ReadBlockHeader(const size_t& offset, BlockHeader& header) const;
+	bool NextBlockHeader(BlockHeader& header, size_t& payloadOffset);
+	bool DecodeSeries(Series& series);
+};
+
+#endif// COUNT_ARCHIVE_H_
@@ -0,0 +1,71 @@
+// File:  countDelta.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Computes download count changes by joining the current observations
+//        against the previous counts in a single sorted merge pass.
+
+// Local headers
+#include "countDelta.h"
+#include "checkedMath.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+void CountDelta::Compute(const CountStore& previous,
+	const std::vector<CountSnapshot::Entry>& current, std::vector<Delta>& deltas)
+{
+	deltas.assign(current.size(), Delta());
+
+	// Sort a permutation rather than the observations, so results land in the
+	// caller's order
+	std::vector<size_t> order(current.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&current](const size_t& a, const size_t& b)
+	{
+		return std::tie(current[a].repo, current[a].tag, current[a].asset)
+			< std::tie(current[b].repo, current[b].tag, current[b].asset);
+	});
+
+	std::vector<CountSnapshot::Entry> entries;
+	size_t i(0);
+	while (i < order.size())
+	{
+		const std::string_view repo(current[order[i]].repo);
+		previous.GetRepoEntries(repo, entries);
+		auto last(entries.cbegin());
+
+		for (; i < order.size() && current[order[i]].repo == repo; ++i)
+		{
+			const CountSnapshot::Entry& observation(current[order[i]]);
+			Delta& delta(deltas[order[i]]);
+
+			while (last != entries.cend() && std::tie(last->tag, last->asset) < std::tie(observation.tag, observation.asset))
+				++last;
+
+			if (last != entries.cend() && last->tag == observation.tag && last->asset == observation.asset)
+			{
+				delta.found = true;
+				delta.previousCount = last->count;
+				delta.previousFlags = last->flags;
+			}
+			delta.change = CheckedDifference(observation.count, delta.previousCount);
+		}
+	}
+}
+
+uint64_t CountDelta::GetCountedTotal(const CountStore& previous, const std::string_view& repo, bool& overflow)
+{
+	std::vector<CountSnapshot::Entry> entries;
+	previous.GetRepoEntries(repo, entries);
+
+	uint64_t total(0);
+	for (const auto& entry : entries)
+	{
+		if (entry.flags & CountSnapshot::Counted)
+			overflow |= !CheckedAdd(total, entry.count);
+	}
+
+	return total;
+}
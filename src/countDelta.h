@@ -0,0 +1,46 @@
+// File:  countDelta.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Computes download count changes by joining the current observations
+//        against the previous snapshot in a single sorted merge pass.
+
+#ifndef COUNT_DELTA_H_
+#define COUNT_DELTA_H_
+
+// Standard C++ headers
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "countStore.h"
+
+class CountDelta
+{
+public:
+	struct Delta
+	{
+		bool found = false;// True if the store held this asset
+		uint64_t previousCount = 0;
+		uint32_t previousFlags = 0;
+		int64_t change = 0;// Saturated at the limits of int64_t
+	};
+
+	// deltas[i] corresponds to current[i].  The observations are visited in
+	// (repo, tag, asset) order, which is the order of the stored entries, so
+	// each repo's entries are read once, front to back.
+	static void Compute(const CountStore& previous,
+		const std::vector<CountSnapshot::Entry>& current, std::vector<Delta>& deltas);
+
+	// True if an observation should be recorded (it's new, or its count or
+	// flags differ from the store)
+	static bool IsChange(const CountSnapshot::Entry& current, const Delta& delta)
+	{
+		return !delta.found || delta.previousCount != current.count || delta.previousFlags != current.flags;
+	}
+
+	// Total of the counted assets of a repo in the store; overflow is set if
+	// the total saturated
+	static uint64_t GetCountedTotal(const CountStore& previous, const std::string_view& repo, bool& overflow);
+};
+
+#endif// COUNT_DELTA_H_
@@ -0,0 +1,243 @@
+// File:  countHistory.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Append-only log of download count samples.  Each poll appends one
+//        batch holding the counts that changed, so the log is a time series of
+//        every (repo, tag, asset) that can be replayed or charted.
+
+// Local headers
+#include "countHistory.h"
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <cstring>
+
+const char CountHistory::magic[8] = { 'G', 'H', 'H', 'I', 'S', 'T', '\r', '\n' };
+
+size_t CountHistory::GetSampleFixedSize(const uint32_t& formatVersion)
+{
+	return sizeof(uint64_t) + (formatVersion < 2 ? 3 : 4) * sizeof(uint16_t);
+}
+
+// FNV-1a
+uint32_t CountHistory::Checksum(const char* data, const size_t& size)
+{
+	uint32_t hash(2166136261u);
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+bool CountHistory::ReadFileHeader(const char* data, const size_t& size, FileHeader& header)
+{
+	if (size < sizeof(header))
+		return false;
+
+	memcpy(&header, data, sizeof(header));
+	return memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version >= 1 && header.version <= version;
+}
+
+void CountHistory::WriteFileHeader(std::string& buffer)
+{
+	FileHeader header;
+	memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.reserved = 0;
+	header.unused = 0;
+	buffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+bool CountHistory::Open(const std::string& fileName)
+{
+	Close();
+	if (!file.Open(fileName))
+		return false;
+
+	FileHeader header;
+	if (!ReadFileHeader(file.GetData(), file.GetSize(), header))
+	{
+		std::cerr << "'" << fileName << "' is not a download history log (or has an unsupported version)\n";
+		Close();
+		return false;
+	}
+
+	fileVersion = header.version;
+	Rewind();
+	return true;
+}
+
+void CountHistory::Close()
+{
+	file.Close();
+	position = 0;
+	damaged = false;
+}
+
+void CountHistory::Rewind()
+{
+	position = sizeof(FileHeader);
+	damaged = false;
+}
+
+bool CountHistory::ReadBatch(const size_t& offset, int64_t& time, std::vector<Sample>& samples, size_t& next) const
+{
+	BatchHeader header;
+	if (file.GetSize() - offset < sizeof(header))
+		return false;
+
+	memcpy(&header, file.GetData() + offset, sizeof(header));
+	const size_t payloadOffset(offset + sizeof(header));
+	if (header.marker != batchMarker || header.payloadSize > file.GetSize() - payloadOffset ||
+		Checksum(file.GetData() + payloadOffset, header.payloadSize) != header.checksum)
+		return false;
+
+	samples.clear();
+	const size_t sampleFixedSize(GetSampleFixedSize(fileVersion));
+	const char* p(file.GetData() + payloadOffset);
+	const char* const end(p + header.payloadSize);
+	for (uint32_t i = 0; i < header.sampleCount; ++i)
+	{
+		if (static_cast<size_t>(end - p) < sampleFixedSize)
+			return false;
+
+		// Version 1 has no flags, leaving lengths[3] zero
+		Sample sample;
+		uint16_t lengths[4] = {};
+		memcpy(&sample.count, p, sizeof(sample.count));
+		memcpy(lengths, p + sizeof(sample.count), sampleFixedSize - sizeof(sample.count));
+		sample.flags = lengths[3];
+		p += sampleFixedSize;
+
+		if (static_cast<size_t>(end - p) < static_cast<size_t>(lengths[0]) + lengths[1] + lengths[2])
+			return false;
+
+		sample.repo = std::string_view(p, lengths[0]);
+		p += lengths[0];
+		sample.tag = std::string_view(p, lengths[1]);
+		p += lengths[1];
+		sample.asset = std::string_view(p, lengths[2]);
+		p += lengths[2];
+		samples.push_back(sample);
+	}
+
+	if (p != end)
+		return false;
+
+	time = header.time;
+	next = payloadOffset + header.payloadSize;
+	return true;
+}
+
+bool CountHistory::NextBatch(int64_t& time, std::vector<Sample>& samples)
+{
+	while (position < file.GetSize())
+	{
+		size_t next;
+		if (ReadBatch(position, time, samples, next))
+		{
+			position = next;
+			return true;
+		}
+
+		// Resynchronize on the next batch marker
+		damaged = true;
+		const char* const data(file.GetData());
+		for (++position; position + sizeof(batchMarker) <= file.GetSize(); ++position)
+		{
+			uint32_t marker;
+			memcpy(&marker, data + position, sizeof(marker));
+			if (marker == batchMarker)
+				break;
+		}
+
+		if (position + sizeof(batchMarker) > file.GetSize())
+			position = file.GetSize();
+	}
+
+	return false;
+}
+
+bool CountHistory::WriteBatch(std::string& buffer, const uint32_t& formatVersion,
+	const int64_t& time, const std::vector<Sample>& samples)
+{
+	const size_t headerOffset(buffer.size());
+	buffer.resize(headerOffset + sizeof(BatchHeader));
+
+	const size_t maxLength(std::numeric_limits<uint16_t>::max());
+	for (const auto& sample : samples)
+	{
+		if (sample.repo.length() > maxLength || sample.tag.length() > maxLength || sample.asset.length() > maxLength)
+		{
+			std::cerr << "Name too long for the download history log:  '" << sample.asset << "'\n";
+			buffer.resize(headerOffset);
+			return false;
+		}
+
+		const uint16_t lengths[4] = { static_cast<uint16_t>(sample.repo.length()),
+			static_cast<uint16_t>(sample.tag.length()), static_cast<uint16_t>(sample.asset.length()),
+			static_cast<uint16_t>(sample.flags) };
+		buffer.append(reinterpret_cast<const char*>(&sample.count), sizeof(sample.count));
+		buffer.append(reinterpret_cast<const char*>(lengths), GetSampleFixedSize(formatVersion) - sizeof(sample.count));
+		buffer.append(sample.repo);
+		buffer.append(sample.tag);
+		buffer.append(sample.asset);
+	}
+
+	const size_t payloadOffset(headerOffset + sizeof(BatchHeader));
+	if (buffer.size() - payloadOffset > std::numeric_limits<uint32_t>::max())
+	{
+		std::cerr << "Too many samples for one download history batch\n";
+		buffer.resize(headerOffset);
+		return false;
+	}
+
+	BatchHeader header;
+	header.marker = batchMarker;
+	header.payloadSize = static_cast<uint32_t>(buffer.size() - payloadOffset);
+	header.time = time;
+	header.sampleCount = static_cast<uint32_t>(samples.size());
+	header.checksum = Checksum(buffer.data() + payloadOffset, header.payloadSize);
+	memcpy(&buffer[headerOffset], &header, sizeof(header));
+
+	return true;
+}
+
+bool CountHistory::Append(const std::string& fileName, const int64_t& time, const std::vector<Sample>& samples)
+{
+	const FileLock lock(fileName);
+	if (!lock.IsLocked())
+		return false;
+
+	std::string buffer;
+	uint32_t formatVersion(version);
+	char headerData[sizeof(FileHeader)];
+	std::ifstream existing(fileName.c_str(), std::ios::binary);
+	if (existing.is_open() && existing.read(headerData, sizeof(headerData)))
+	{
+		FileHeader header;
+		if (!ReadFileHeader(headerData, sizeof(headerData), header))
+		{
+			std::cerr << "'" << fileName << "' is not a download history log (or has an unsupported version)\n";
+			return false;
+		}
+		formatVersion = header.version;
+	}
+	else
+		WriteFileHeader(buffer);
+	existing.close();
+
+	return WriteBatch(buffer, formatVersion, time, samples) && AppendDurably(fileName, buffer.data(), buffer.size());
+}
+
+bool CountHistory::Reset(const std::string& fileName)
+{
+	std::string buffer;
+	WriteFileHeader(buffer);
+	return ReplaceDurably(fileName, buffer.data(), buffer.size());
+}
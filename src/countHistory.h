@@ -0,0 +1,103 @@
+// File:  countHistory.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Append-only log of download count samples.  Each poll appends one
+//        batch holding the counts that changed, so the log is a time series of
+//        every (repo, tag, asset) that can be replayed or charted.
+
+#ifndef COUNT_HISTORY_H_
+#define COUNT_HISTORY_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Local headers
+#include "mappedFile.h"
+
+// File layout (host byte order):
+//   FileHeader
+//   Batches, each a BatchHeader followed by sampleCount samples of:
+//     uint64_t count
+//     uint16_t repoLength, tagLength, assetLength
+//     uint16_t flags (CountSnapshot::Flags; not present in version 1)
+//     repo, tag and asset text (not terminated)
+// A batch is only valid if its checksum matches, so a batch torn by a crash
+// is skipped on reading and dropped when the log is next archived.
+class CountHistory
+{
+public:
+	static constexpr uint32_t version = 2;
+
+	struct Sample
+	{
+		std::string_view repo;
+		std::string_view tag;
+		std::string_view asset;
+		uint64_t count = 0;
+		uint32_t flags = 0;
+	};
+
+	// A missing file fails quietly
+	bool Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// Reads batches in the order they were appended; views point into the
+	// mapping.  Returns false at the end of the log.
+	bool NextBatch(int64_t& time, std::vector<Sample>& samples);
+	void Rewind();
+
+	// True if any bytes had to be skipped (e.g. following a crash mid-append)
+	bool HasDamage() const { return damaged; }
+
+	// Writes the batch with a single write and a single sync, in the format
+	// version of the existing file.  Appends hold the log's FileLock, so
+	// concurrent pollers never lose a batch.
+	static bool Append(const std::string& fileName, const int64_t& time, const std::vector<Sample>& samples);
+
+	// Replaces the log with an empty one; the caller must hold its FileLock
+	static bool Reset(const std::string& fileName);
+
+	// FNV-1a, used to validate batches (and archive blocks)
+	static uint32_t Checksum(const char* data, const size_t& size);
+
+private:
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t reserved;
+		uint64_t unused;// Formerly the size following the last compaction
+	};
+
+	struct BatchHeader
+	{
+		uint32_t marker;
+		uint32_t payloadSize;
+		int64_t time;
+		uint32_t sampleCount;
+		uint32_t checksum;// Of the payload
+	};
+
+	static const char magic[8];
+	static constexpr uint32_t batchMarker = 0x48435442;// "BTCH"
+
+	MappedFile file;
+	uint32_t fileVersion = version;
+	size_t position = 0;
+	bool damaged = false;
+
+	bool ReadBatch(const size_t& offset, int64_t& time, std::vector<Sample>& samples, size_t& next) const;
+
+	static bool ReadFileHeader(const char* data, const size_t& size, FileHeader& header);
+	static void WriteFileHeader(std::string& buffer);
+	static bool WriteBatch(std::string& buffer, const uint32_t& formatVersion,
+		const int64_t& time, const std::vector<Sample>& samples);
+	static size_t GetSampleFixedSize(const uint32_t& formatVersion);
+};
+
+#endif// COUNT_HISTORY_H_
@@ -0,0 +1,321 @@
+// File:  countQuery.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Answers questions over the recorded download history (the archive
+//        plus the history log):  downloads in a time window, growth over the
+//        window before it, and when assets were first seen and last changed.
+//        Whole buckets of a window come from the rollups; only the partial
+//        buckets at its ends are replayed from the samples, whose times and
+//        counts are held in flat arrays (a few binary searches per series).
+
+// Local headers
+#include "countQuery.h"
+#include "countArchive.h"
+#include "countHistory.h"
+#include "checkedMath.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+
+// Identifies a series or a group by the ids of its names, so lookups hash
+// and compare two integers instead of strings
+struct NameKey
+{
+	NameKey(const InternedString& owner, const InternedString& repo, const InternedString& tag, const InternedString& asset)
+		: high(static_cast<uint64_t>(owner.GetId()) << 32 | repo.GetId()),
+		low(static_cast<uint64_t>(tag.GetId()) << 32 | asset.GetId()) {}
+
+	uint64_t high;
+	uint64_t low;
+
+	bool operator==(const NameKey& other) const { return high == other.high && low == other.low; }
+};
+
+struct NameKeyHash
+{
+	size_t operator()(const NameKey& key) const
+	{
+		// Ids are small and dense, so the bits need mixing
+		uint64_t h(key.high * 0x9E3779B97F4A7C15 ^ key.low);
+		h ^= h >> 29;
+		h *= 0xBF58476D1CE4E5B9;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+};
+
+// Maps each key to the position of its entry in a vector
+typedef std::unordered_map<NameKey, size_t, NameKeyHash> NameIndex;
+
+bool CountQuery::Load(const std::string& owner, const std::string& archiveFileName,
+	const std::string& historyFileName, const std::string& rollupFileName)
+{
+	struct Staged
+	{
+		InternedString repo;
+		InternedString tag;
+		InternedString asset;
+		std::vector<std::pair<int64_t, uint64_t>> points;
+	};
+
+	const InternedString ownerName(owner);
+	std::vector<Staged> staged;
+	NameIndex stagedIndex;
+	const auto stage([&](const std::string_view& repo, const std::string_view& tag, const std::string_view& asset)
+		-> std::vector<std::pair<int64_t, uint64_t>>&
+	{
+		const InternedString repoName(repo), tagName(tag), assetName(asset);
+		const auto entry(stagedIndex.emplace(NameKey(ownerName, repoName, tagName, assetName), staged.size()));
+		if (entry.second)
+			staged.push_back({ repoName, tagName, assetName, {} });
+		return staged[entry.first->second].points;
+	});
+
+	std::error_code error;
+
+	// The archive and the log hold different batches.  The log is read first:
+	// if its batches move to the archive in the meantime, they're seen twice
+	// rather than not at all.
+	CountHistory history;
+	if (history.Open(historyFileName))
+	{
+		int64_t time;
+		std::vector<CountHistory::Sample> samples;
+		while (history.NextBatch(time, samples))
+		{
+			for (const auto& sample : samples)
+				stage(sample.repo, sample.tag, sample.asset).push_back(std::make_pair(time, sample.count));
+		}
+	}
+	else if (std::filesystem::exists(historyFileName, error))
+		return false;
+
+	CountArchive archive;
+	if (archive.Open(archiveFileName))
+	{
+		CountArchive::Series s;
+		while (archive.NextBlock())
+		{
+			while (archive.NextSeries(s))
+			{
+				auto& points(stage(s.repo, s.tag, s.asset));
+				for (const auto& point : s.points)
+					points.push_back(std::make_pair(point.time, point.count));
+			}
+		}
+
+		if (archive.HasDamage())
+			std::cerr << "Skipped damaged blocks in '" << archiveFileName << "'\n";
+	}
+	else if (std::filesystem::exists(archiveFileName, error))
+		return false;
+
+	std::unordered_map<InternedString, int64_t> repoFirstSeen;
+	const size_t firstSeries(series.size());
+	for (auto& s : staged)
+	{
+		// Batches appended by concurrent processes can be slightly out of
+		// order, and a batch can be in both files
+		std::sort(s.points.begin(), s.points.end());
+		s.points.erase(std::unique(s.points.begin(), s.points.end()), s.points.end());
+
+		Series info;
+		info.owner = ownerName;
+		info.repo = s.repo;
+		info.tag = s.tag;
+		info.asset = s.asset;
+		info.begin = times.size();
+		for (const auto& point : s.points)
+		{
+			times.push_back(point.first);
+			counts.push_back(point.second);
+		}
+		info.end = times.size();
+		series.push_back(info);
+
+		auto first(repoFirstSeen.emplace(info.repo, times[info.begin]).first);
+		first->second = std::min(first->second, times[info.begin]);
+	}
+
+	for (size_t i = firstSeries; i < series.size(); ++i)
+		series[i].repoFirstSeen = repoFirstSeen[series[i].repo];
+
+	// Read last, so a poll recorded meanwhile is missing from the samples
+	// rather than from the rollups (it still counts, but without its times)
+	owners.push_back({ ownerName, CountRollups(), firstSeries, series.size() });
+	if (!owners.back().rollups.Load(rollupFileName))
+		return false;
+
+	return true;
+}
+
+bool CountQuery::GetCountAt(const Series& s, const int64_t& time, uint64_t& count) const
+{
+	const auto after(std::upper_bound(times.begin() + s.begin, times.begin() + s.end, time));
+	if (after == times.begin() + s.begin)
+	{
+		count = 0;
+		return false;
+	}
+
+	count = counts[after - times.begin() - 1];
+	return true;
+}
+
+uint64_t CountQuery::GetDownloads(const Series& s, const int64_t& begin, const int64_t& end) const
+{
+	uint64_t endCount, beginCount;
+	if (!GetCountAt(s, end, endCount))
+		return 0;
+
+	if (!GetCountAt(s, begin, beginCount) && times[s.begin] == s.repoFirstSeen)
+		beginCount = counts[s.begin];
+
+	// A count that went down (e.g. a replaced asset) contributes nothing
+	return endCount > beginCount ? endCount - beginCount : 0;
+}
+
+void CountQuery::Split(const CountRollups& rollups, const int64_t& begin, const int64_t& end,
+	const int& granularity, std::vector<Span>& spans)
+{
+	for (int g = granularity; g >= 0; --g)
+	{
+		const CountRollups::Granularity bucket(static_cast<CountRollups::Granularity>(g));
+		const int64_t length(CountRollups::GetBucketLength(bucket));
+		const int64_t first(std::max(CountRollups::GetBucketStart(bucket, begin + length - 1), rollups.GetCoveredFrom(bucket)));
+		const int64_t last(CountRollups::GetBucketStart(bucket, end));
+		if (first < last)
+		{
+			Split(rollups, begin, first, g - 1, spans);
+			spans.push_back({ first, last, true, bucket });
+			Split(rollups, last, end, g - 1, spans);
+			return;
+		}
+	}
+
+	if (begin < end)
+		spans.push_back({ begin, end, false, CountRollups::Hourly });
+}
+
+void CountQuery::Run(const CountRollups::Level& level, const int64_t& begin, const int64_t& end,
+	std::vector<Result>& results) const
+{
+	results.clear();
+
+	NameIndex groups;
+	groups.reserve(series.size());
+	const int64_t length(end - begin);
+	std::vector<Span> spans, previousSpans;
+	for (const auto& owner : owners)
+	{
+		// Downloads are attributed to the poll that saw them, so the window
+		// (begin, end] holds the polls at times [begin + 1, end + 1)
+		spans.clear();
+		previousSpans.clear();
+		Split(owner.rollups, begin + 1, end + 1, CountRollups::GranularityCount - 1, spans);
+		Split(owner.rollups, begin - length + 1, begin + 1, CountRollups::GranularityCount - 1, previousSpans);
+
+		for (size_t i = owner.seriesBegin; i < owner.seriesEnd; ++i)
+		{
+			const Series& s(series[i]);
+			const auto last(std::upper_bound(times.begin() + s.begin, times.begin() + s.end, end));
+			if (last == times.begin() + s.begin)
+				continue;// Not seen by the end of the window
+
+			const InternedString tag(level == CountRollups::Repo ? InternedString() : s.tag);
+			const InternedString asset(level == CountRollups::Asset ? s.asset : InternedString());
+			const auto group(groups.emplace(NameKey(s.owner, s.repo, tag, asset), results.size()));
+			if (group.second)
+				results.push_back({ s.owner, s.repo, tag, asset, 0, 0, times[s.begin], *(last - 1) });
+
+			Result& result(results[group.first->second]);
+			for (const auto& span : spans)
+			{
+				if (!span.fromRollups)
+					CheckedAdd(result.downloads, GetDownloads(s, span.begin - 1, span.end - 1));
+			}
+			for (const auto& span : previousSpans)
+			{
+				if (!span.fromRollups)
+					CheckedAdd(result.previousDownloads, GetDownloads(s, span.begin - 1, span.end - 1));
+			}
+			result.firstSeen = std::min(result.firstSeen, times[s.begin]);
+			result.lastChange = std::max(result.lastChange, *(last - 1));
+		}
+
+		const auto addRows([&](const std::vector<Span>& windowSpans, uint64_t Result::*downloads)
+		{
+			for (const auto& span : windowSpans)
+			{
+				if (!span.fromRollups)
+					continue;
+
+				const CountRollups::Row* row;
+				const CountRollups::Row* lastRow;
+				owner.rollups.GetRows(span.granularity, level, span.begin, span.end, row, lastRow);
+				for (; row != lastRow; ++row)
+				{
+					const auto group(groups.emplace(NameKey(owner.name, row->repo, row->tag, row->asset), results.size()));
+					if (group.second)// No samples were read for it; see Load()
+						results.push_back({ owner.name, row->repo, row->tag, row->asset, 0, 0, row->bucket, row->bucket });
+					CheckedAdd(results[group.first->second].*downloads, row->downloads);
+				}
+			}
+		});
+
+		addRows(spans, &Result::downloads);
+		addRows(previousSpans, &Result::previousDownloads);
+	}
+}
+
+bool CountQuery::GetGrowth(const Result& result, double& growth)
+{
+	if (result.previousDownloads == 0)
+		return false;
+
+	growth = (static_cast<double>(result.downloads) - static_cast<double>(result.previousDownloads))
+		/ static_cast<double>(result.previousDownloads);
+	return true;
+}
+
+void CountQuery::Top(std::vector<Result>& results, const SortKey& key, const size_t& n)
+{
+	const auto greater([&key](const Result& a, const Result& b)
+	{
+		switch (key)
+		{
+		case Growth:
+		{
+			double growthA, growthB;
+			const bool hasA(GetGrowth(a, growthA));
+			const bool hasB(GetGrowth(b, growthB));
+			if (hasA != hasB)
+				return hasA;
+			else if (hasA && growthA != growthB)
+				return growthA > growthB;
+			break;
+		}
+
+		case FirstSeen:
+			if (a.firstSeen != b.firstSeen)
+				return a.firstSeen > b.firstSeen;
+			break;
+
+		case LastChange:
+			if (a.lastChange != b.lastChange)
+				return a.lastChange > b.lastChange;
+			break;
+
+		default:
+			break;
+		}
+
+		return a.downloads > b.downloads;
+	});
+
+	const size_t count(std::min(n, results.size()));
+	std::partial_sort(results.begin(), results.begin() + count, results.end(), greater);
+	results.resize(count);
+}
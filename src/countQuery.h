@@ -0,0 +1,111 @@
+// File:  countQuery.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Answers questions over the recorded download history (the archive
+//        plus the history log):  downloads in a time window, growth over the
+//        window before it, and when assets were first seen and last changed.
+//        Whole buckets of a window come from the rollups; only the partial
+//        buckets at its ends are replayed from the samples, whose times and
+//        counts are held in flat arrays (a few binary searches per series).
+
+#ifndef COUNT_QUERY_H_
+#define COUNT_QUERY_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "countRollups.h"
+#include "stringInterner.h"
+
+class CountQuery
+{
+public:
+	enum SortKey
+	{
+		Downloads,
+		Growth,
+		FirstSeen,
+		LastChange
+	};
+
+	struct Result
+	{
+		InternedString owner;
+		InternedString repo;
+		InternedString tag;// Empty when grouping by repo
+		InternedString asset;// Empty unless grouping by asset
+		uint64_t downloads;// In the window
+		uint64_t previousDownloads;// In the window of the same length before it
+		int64_t firstSeen;
+		int64_t lastChange;// Samples are only recorded when a count changes
+	};
+
+	// Adds an owner's samples and rollups; missing files are treated as empty
+	bool Load(const std::string& owner, const std::string& archiveFileName,
+		const std::string& historyFileName, const std::string& rollupFileName);
+
+	// Downloads in (begin, end], grouped by asset, release or repo, counting
+	// each increase at the poll that saw it (as the rollups do).  A series
+	// starting after begin counts from zero if its repo was seen before it
+	// (it's a new asset), or else from its first sample (the repo wasn't being
+	// polled yet, so the count includes downloads from before the window).
+	void Run(const CountRollups::Level& level, const int64_t& begin, const int64_t& end,
+		std::vector<Result>& results) const;
+
+	// Keeps the first n results when ordered by key (largest downloads or
+	// growth, or most recent times, first), using a partial sort.  Results
+	// with undefined growth follow the others when sorting by growth.
+	static void Top(std::vector<Result>& results, const SortKey& key, const size_t& n);
+
+	// Relative change from the previous window; false if it had no downloads
+	static bool GetGrowth(const Result& result, double& growth);
+
+private:
+	struct Series
+	{
+		InternedString owner;
+		InternedString repo;
+		InternedString tag;
+		InternedString asset;
+		size_t begin;// Range of the points in times and counts
+		size_t end;
+		int64_t repoFirstSeen;
+	};
+
+	std::vector<Series> series;
+	std::vector<int64_t> times;
+	std::vector<uint64_t> counts;
+
+	struct Owner
+	{
+		InternedString name;
+		CountRollups rollups;
+		size_t seriesBegin;// Range of the owner's entries in series
+		size_t seriesEnd;
+	};
+
+	std::vector<Owner> owners;
+
+	struct Span
+	{
+		int64_t begin;// Poll times in [begin, end)
+		int64_t end;
+		bool fromRollups;// Otherwise replayed from the samples
+		CountRollups::Granularity granularity;
+	};
+
+	// Splits poll times [begin, end) into the longest bucket-aligned spans
+	// the rollups cover at granularity or finer, and the remainder
+	static void Split(const CountRollups& rollups, const int64_t& begin, const int64_t& end,
+		const int& granularity, std::vector<Span>& spans);
+
+	// Count as of time (or zero before the first sample), and whether there
+	// was a sample by then
+	bool GetCountAt(const Series& s, const int64_t& time, uint64_t& count) const;
+	uint64_t GetDownloads(const Series& s, const int64_t& begin, const int64_t& end) const;
+};
+
+#endif// COUNT_QUERY_H_
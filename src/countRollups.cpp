@@ -0,0 +1,267 @@
+// File:  countRollups.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download totals per asset, release and repo in hourly, daily and
+//        weekly buckets.  Each poll adds its deltas to the buckets containing
+//        the poll time, so reports over a window read only that window's rows
+//        instead of replaying the history.
+
+// Local headers
+#include "countRollups.h"
+#include "mappedFile.h"
+#include "durableWrite.h"
+#include "checkedMath.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_set>
+#include <string_view>
+#include <limits>
+#include <tuple>
+#include <cstring>
+
+const char CountRollups::magic[8] = { 'G', 'H', 'R', 'O', 'L', 'L', '\r', '\n' };
+
+// Zero keeps buckets indefinitely
+const int64_t CountRollups::retention[GranularityCount] =
+{
+	31 * 24 * 3600,// Hourly
+	2 * 366 * 24 * 3600,// Daily
+	0// Weekly
+};
+
+int64_t CountRollups::GetBucketLength(const Granularity& granularity)
+{
+	switch (granularity)
+	{
+	case Hourly:
+		return 3600;
+
+	case Daily:
+		return 24 * 3600;
+
+	default:
+		return 7 * 24 * 3600;
+	}
+}
+
+int64_t CountRollups::GetBucketStart(const Granularity& granularity, const int64_t& time)
+{
+	// The epoch fell on a Thursday, so weeks are offset to start on Monday
+	const int64_t offset(granularity == Weekly ? 3 * 24 * 3600 : 0);
+	const int64_t length(GetBucketLength(granularity));
+	int64_t bucket((time + offset) / length);
+	if ((time + offset) % length < 0)
+		--bucket;// Round toward negative infinity
+	return bucket * length - offset;
+}
+
+bool CountRollups::RowLess(const Row& a, const Row& b)
+{
+	return std::tie(a.bucket, a.repo, a.tag, a.asset) < std::tie(b.bucket, b.repo, b.tag, b.asset);
+}
+
+bool CountRollups::Load(const std::string& fileName)
+{
+	for (auto& granularityTables : tables)
+	{
+		for (auto& table : granularityTables)
+			table.clear();
+	}
+	std::fill(coveredFrom, coveredFrom + GranularityCount, std::numeric_limits<int64_t>::max());
+
+	MappedFile file;
+	if (!file.Open(fileName))
+	{
+		std::error_code error;
+		return !std::filesystem::exists(fileName, error);
+	}
+
+	static_assert(sizeof(FileHeader) == 40, "Rollup header must be packed");
+
+	FileHeader header = {};
+	memcpy(&header, file.GetData(), std::min(file.GetSize(), sizeof(header)));
+
+	// Version 1 files may be missing polls, so they're started over
+	if (memcmp(header.magic, magic, sizeof(magic)) == 0 && header.version == 1)
+		return true;
+	else if (file.GetSize() < sizeof(header) || memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+	{
+		std::cerr << "'" << fileName << "' is not a download rollup file (or has an unsupported version)\n";
+		return false;
+	}
+
+	std::copy(header.coveredFrom, header.coveredFrom + GranularityCount, coveredFrom);
+
+	const size_t fixedSize(2 * sizeof(uint64_t) + 2 * sizeof(uint8_t) + 3 * sizeof(uint16_t));
+	const char* p(file.GetData() + sizeof(header));
+	const char* const end(file.GetData() + file.GetSize());
+	for (uint32_t i = 0; i < header.rowCount; ++i)
+	{
+		if (static_cast<size_t>(end - p) < fixedSize)
+			break;
+
+		Row row;
+		uint8_t granularity, level;
+		uint16_t lengths[3];
+		memcpy(&row.bucket, p, sizeof(row.bucket));
+		memcpy(&row.downloads, p + 8, sizeof(row.downloads));
+		memcpy(&granularity, p + 16, sizeof(granularity));
+		memcpy(&level, p + 17, sizeof(level));
+		memcpy(lengths, p + 18, sizeof(lengths));
+		p += fixedSize;
+
+		if (granularity >= GranularityCount || level >= LevelCount ||
+			static_cast<size_t>(end - p) < static_cast<size_t>(lengths[0]) + lengths[1] + lengths[2])
+			break;
+
+		row.repo = InternedString(std::string_view(p, lengths[0]));
+		p += lengths[0];
+		row.tag = InternedString(std::string_view(p, lengths[1]));
+		p += lengths[1];
+		row.asset = InternedString(std::string_view(p, lengths[2]));
+		p += lengths[2];
+
+		tables[granularity][level].push_back(row);
+	}
+
+	if (p != end)
+	{
+		std::cerr << "Download rollup file '" << fileName << "' is truncated or corrupt\n";
+		return false;
+	}
+
+	// Ids depend on the order strings were interned in this process
+	for (auto& granularityTables : tables)
+	{
+		for (auto& table : granularityTables)
+			std::sort(table.begin(), table.end(), RowLess);
+	}
+
+	return true;
+}
+
+bool CountRollups::Save(const std::string& fileName) const
+{
+	std::string buffer;
+	buffer.resize(sizeof(FileHeader));
+
+	uint32_t rowCount(0);
+	const size_t maxLength(std::numeric_limits<uint16_t>::max());
+	for (uint8_t granularity = 0; granularity < GranularityCount; ++granularity)
+	{
+		for (uint8_t level = 0; level < LevelCount; ++level)
+		{
+			for (const auto& row : tables[granularity][level])
+			{
+				const std::string_view repo(row.repo.View()), tag(row.tag.View()), asset(row.asset.View());
+				if (repo.length() > maxLength || tag.length() > maxLength || asset.length() > maxLength)
+				{
+					std::cerr << "Name too long for the download rollups:  '" << asset << "'\n";
+					return false;
+				}
+
+				const uint16_t lengths[3] = { static_cast<uint16_t>(repo.length()),
+					static_cast<uint16_t>(tag.length()), static_cast<uint16_t>(asset.length()) };
+				buffer.append(reinterpret_cast<const char*>(&row.bucket), sizeof(row.bucket));
+				buffer.append(reinterpret_cast<const char*>(&row.downloads), sizeof(row.downloads));
+				buffer.push_back(static_cast<char>(granularity));
+				buffer.push_back(static_cast<char>(level));
+				buffer.append(reinterpret_cast<const char*>(lengths), sizeof(lengths));
+				buffer.append(repo);
+				buffer.append(tag);
+				buffer.append(asset);
+				++rowCount;
+			}
+		}
+	}
+
+	FileHeader header;
+	memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.rowCount = rowCount;
+	std::copy(coveredFrom, coveredFrom + GranularityCount, header.coveredFrom);
+	memcpy(&buffer[0], &header, sizeof(header));
+
+	return ReplaceDurably(fileName, buffer.data(), buffer.size());
+}
+
+void CountRollups::AddToBucket(std::vector<Row>& table, const Row& row)
+{
+	// The current bucket is at (or near) the end, so this rarely moves much
+	auto position(std::lower_bound(table.begin(), table.end(), row, RowLess));
+	if (position != table.end() && !RowLess(row, *position))
+		CheckedAdd(position->downloads, row.downloads);// Saturates
+	else
+		table.insert(position, row);
+}
+
+void CountRollups::Add(const int64_t& time, const std::vector<CountSnapshot::Entry>& current,
+	const std::vector<CountDelta::Delta>& deltas)
+{
+	// Polls before this one weren't added, so coverage starts with the next
+	// bucket (or this one, if the poll is on its boundary)
+	for (int granularity = 0; granularity < GranularityCount; ++granularity)
+	{
+		const int64_t length(GetBucketLength(static_cast<Granularity>(granularity)));
+		if (coveredFrom[granularity] == std::numeric_limits<int64_t>::max())
+			coveredFrom[granularity] = GetBucketStart(static_cast<Granularity>(granularity), time + length - 1);
+	}
+
+	std::unordered_set<std::string_view> knownRepos;
+	for (size_t i = 0; i < current.size(); ++i)
+	{
+		if (deltas[i].found)
+			knownRepos.insert(current[i].repo);
+	}
+
+	for (size_t i = 0; i < current.size(); ++i)
+	{
+		// Counts that went down (e.g. a replaced asset) contribute nothing
+		if (deltas[i].change <= 0 || knownRepos.find(current[i].repo) == knownRepos.end())
+			continue;
+
+		const InternedString repo(current[i].repo);
+		const InternedString tag(current[i].tag);
+		const InternedString asset(current[i].asset);
+		const uint64_t downloads(static_cast<uint64_t>(deltas[i].change));
+		for (int granularity = 0; granularity < GranularityCount; ++granularity)
+		{
+			const int64_t bucket(GetBucketStart(static_cast<Granularity>(granularity), time));
+			AddToBucket(tables[granularity][Asset], { bucket, repo, tag, asset, downloads });
+			AddToBucket(tables[granularity][Release], { bucket, repo, tag, InternedString(), downloads });
+			AddToBucket(tables[granularity][Repo], { bucket, repo, InternedString(), InternedString(), downloads });
+		}
+	}
+
+	for (int granularity = 0; granularity < GranularityCount; ++granularity)
+	{
+		if (retention[granularity] == 0)
+			continue;
+
+		const int64_t oldest(GetBucketStart(static_cast<Granularity>(granularity), time - retention[granularity]));
+		coveredFrom[granularity] = std::max(coveredFrom[granularity], oldest);
+		for (auto& table : tables[granularity])
+		{
+			table.erase(table.begin(), std::lower_bound(table.begin(), table.end(), oldest, [](const Row& row, const int64_t& bucket)
+			{
+				return row.bucket < bucket;
+			}));
+		}
+	}
+}
+
+void CountRollups::GetRows(const Granularity& granularity, const Level& level, const int64_t& begin, const int64_t& end,
+	const Row*& first, const Row*& last) const
+{
+	const std::vector<Row>& table(tables[granularity][level]);
+	const auto bucketLess([](const Row& row, const int64_t& bucket)
+	{
+		return row.bucket < bucket;
+	});
+
+	first = table.data() + (std::lower_bound(table.begin(), table.end(), begin, bucketLess) - table.begin());
+	last = table.data() + (std::lower_bound(table.begin(), table.end(), end, bucketLess) - table.begin());
+}
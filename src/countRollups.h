@@ -0,0 +1,115 @@
+// File:  countRollups.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download totals per asset, release and repo in hourly, daily and
+//        weekly buckets.  Each poll adds its deltas to the buckets containing
+//        the poll time, so reports over a window read only that window's rows
+//        instead of replaying the history.
+
+#ifndef COUNT_ROLLUPS_H_
+#define COUNT_ROLLUPS_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+// Local headers
+#include "countDelta.h"
+#include "stringInterner.h"
+
+// File layout (host byte order):
+//   FileHeader (including the coverage of each granularity)
+//   rowCount rows of:
+//     int64_t bucket
+//     uint64_t downloads
+//     uint8_t granularity, level
+//     uint16_t repoLength, tagLength, assetLength
+//     repo, tag and asset text (not terminated)
+// The file is small (old buckets are dropped; see retention), so it's
+// rewritten in full after each poll.
+class CountRollups
+{
+public:
+	static constexpr uint32_t version = 2;
+
+	enum Granularity
+	{
+		Hourly,
+		Daily,
+		Weekly,
+		GranularityCount
+	};
+
+	enum Level
+	{
+		Asset,
+		Release,// Asset is empty
+		Repo,// Tag and asset are empty
+		LevelCount
+	};
+
+	struct Row
+	{
+		int64_t bucket;// Start time of the bucket
+		InternedString repo;
+		InternedString tag;
+		InternedString asset;
+		uint64_t downloads;
+	};
+
+	// A missing file (or one from an older version, which didn't record its
+	// coverage) leaves the rollups empty
+	bool Load(const std::string& fileName);
+	bool Save(const std::string& fileName) const;
+
+	// Adds the increase in each observation since the last poll to the
+	// buckets containing time, and drops buckets older than their retention.
+	// Must be called for every poll that records a change (those that don't
+	// add nothing), or the coverage is wrong.
+	// Downloads between polls all land in the bucket of the later poll.
+	// Assets seen for the first time only count if other assets of the same
+	// repo were seen before; otherwise the first poll of a repo would report
+	// its lifetime downloads as recent.
+	void Add(const int64_t& time, const std::vector<CountSnapshot::Entry>& current,
+		const std::vector<CountDelta::Delta>& deltas);
+
+	// Rows of one table in buckets starting within [begin, end), ordered by
+	// bucket.  Found by binary search, so the cost is the size of the window.
+	void GetRows(const Granularity& granularity, const Level& level, const int64_t& begin, const int64_t& end,
+		const Row*& first, const Row*& last) const;
+
+	// Buckets starting at or after this time hold every poll since; earlier
+	// polls predate the rollups or have passed their retention.  The maximum
+	// int64_t if nothing has been added.
+	int64_t GetCoveredFrom(const Granularity& granularity) const { return coveredFrom[granularity]; }
+
+	// UTC hours, days and weeks (starting on Monday)
+	static int64_t GetBucketStart(const Granularity& granularity, const int64_t& time);
+	static int64_t GetBucketLength(const Granularity& granularity);
+
+	// How long (in seconds) each granularity's buckets are kept
+	static const int64_t retention[GranularityCount];
+
+private:
+	struct FileHeader
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t rowCount;
+		int64_t coveredFrom[GranularityCount];
+	};
+
+	static const char magic[8];
+
+	int64_t coveredFrom[GranularityCount];
+
+	// Sorted by bucket, then by the ids of the names
+	std::vector<Row> tables[GranularityCount][LevelCount];
+
+	void AddToBucket(std::vector<Row>& table, const Row& row);
+	static bool RowLess(const Row& a, const Row& b);
+};
+
+#endif// COUNT_ROLLUPS_H_
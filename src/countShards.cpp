@@ -0,0 +1,126 @@
+// File:  countShards.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download count stores sharded by repository owner.  Each owner gets
+//        its own snapshot, log, history, archive and rollup files, so a run
+//        only maps the owner it polls, repos with the same name under
+//        different owners don't collide, and processes polling different
+//        owners never write the same file.  An index lists the owners that
+//        have shards.
+
+// Local headers
+#include "countShards.h"
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <set>
+
+std::string CountShards::GetIndexFileName() const
+{
+	return (std::filesystem::path(directory) / "index").string();
+}
+
+std::string CountShards::GetShardPath(const std::string& owner) const
+{
+	return (std::filesystem::path(directory) / GetShardName(owner)).string();
+}
+
+std::string CountShards::GetShardName(const std::string& owner)
+{
+	const char hexDigits[] = "0123456789abcdef";
+	std::string name;
+	for (const char& c : owner)
+	{
+		const unsigned char u(static_cast<unsigned char>(c));
+		if (u >= 'A' && u <= 'Z')
+			name.push_back(static_cast<char>(u - 'A' + 'a'));
+		else if ((u >= 'a' && u <= 'z') || (u >= '0' && u <= '9') || u == '-' || u == '_')
+			name.push_back(c);
+		else
+		{
+			name.push_back('%');
+			name.push_back(hexDigits[u >> 4]);
+			name.push_back(hexDigits[u & 0xf]);
+		}
+	}
+	return name;
+}
+
+bool CountShards::ReadIndex(std::vector<std::string>& owners) const
+{
+	owners.clear();
+	const std::string indexFileName(GetIndexFileName());
+	std::ifstream file(indexFileName.c_str());
+	if (!file.is_open())
+	{
+		std::error_code error;
+		if (!std::filesystem::exists(indexFileName, error))
+			return true;
+
+		std::cerr << "Failed to open '" << indexFileName << "' for input\n";
+		return false;
+	}
+
+	// Processes registering the same owner at once may both append it, so
+	// duplicates are dropped here
+	std::set<std::string> shardNames;
+	std::string owner;
+	while (std::getline(file, owner))
+	{
+		if (!owner.empty() && shardNames.insert(GetShardName(owner)).second)
+			owners.push_back(owner);
+	}
+
+	return true;
+}
+
+bool CountShards::Exists(const std::string& owner) const
+{
+	std::error_code error;
+	return std::filesystem::exists(GetSnapshotFileName(owner), error) ||
+		std::filesystem::exists(GetLogFileName(owner), error);
+}
+
+bool CountShards::Register(const std::string& owner) const
+{
+	if (owner.empty() || owner.find('\n') != std::string::npos)
+	{
+		std::cerr << "Invalid owner name for download counts:  '" << owner << "'\n";
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error)
+	{
+		std::cerr << "Failed to create '" << directory << "':  " << error.message() << '\n';
+		return false;
+	}
+
+	std::vector<std::string> owners;
+	if (!ReadIndex(owners))
+		return false;
+
+	const std::string shardName(GetShardName(owner));
+	if (std::any_of(owners.begin(), owners.end(), [&shardName](const std::string& o)
+	{
+		return GetShardName(o) == shardName;
+	}))
+		return true;
+
+	// A single appended line, so concurrent registrations don't interleave
+	const std::string line(owner + '\n');
+	return AppendDurably(GetIndexFileName(), line.data(), line.size());
+}
+
+bool CountShards::Open(const std::string& owner, CountStore& store) const
+{
+	if (!Register(owner))
+		return false;
+
+	return store.Open(GetSnapshotFileName(owner), GetLogFileName(owner));
+}
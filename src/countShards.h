@@ -0,0 +1,56 @@
+// File:  countShards.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download count stores sharded by repository owner.  Each owner gets
+//        its own snapshot, log, history, archive and rollup files, so a run
+//        only maps the owner it polls, repos with the same name under
+//        different owners don't collide, and processes polling different
+//        owners never write the same file.  An index lists the owners that
+//        have shards.
+
+#ifndef COUNT_SHARDS_H_
+#define COUNT_SHARDS_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "countStore.h"
+
+class CountShards
+{
+public:
+	explicit CountShards(const std::string& directory) : directory(directory) {}
+
+	// Owners that have shards, in the order they were added (a missing index
+	// means there are none)
+	bool ReadIndex(std::vector<std::string>& owners) const;
+
+	// True if the owner's snapshot or log exists
+	bool Exists(const std::string& owner) const;
+
+	// Creates the shard directory and adds the owner to the index, if needed
+	bool Register(const std::string& owner) const;
+
+	// Registers the owner and opens its store
+	bool Open(const std::string& owner, CountStore& store) const;
+
+	std::string GetSnapshotFileName(const std::string& owner) const { return GetShardPath(owner) + ".snapshot"; }
+	std::string GetLogFileName(const std::string& owner) const { return GetShardPath(owner) + ".log"; }
+	std::string GetHistoryFileName(const std::string& owner) const { return GetShardPath(owner) + ".history"; }
+	std::string GetArchiveFileName(const std::string& owner) const { return GetShardPath(owner) + ".archive"; }
+	std::string GetRollupFileName(const std::string& owner) const { return GetShardPath(owner) + ".rollups"; }
+
+private:
+	const std::string directory;
+
+	std::string GetIndexFileName() const;
+	std::string GetShardPath(const std::string& owner) const;
+
+	// Owner names are case-insensitive, so shards are named with the lowercase
+	// name, escaping anything that isn't safe in a file name
+	static std::string GetShardName(const std::string& owner);
+};
+
+#endif// COUNT_SHARDS_H_
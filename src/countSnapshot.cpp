@@ -0,0 +1,288 @@
+// File:  countSnapshot.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Versioned binary snapshot of the most recent download count of each
+//        (repo, tag, asset).  The file is memory mapped and queried in place,
+//        so opening it costs the same regardless of how much it holds.
+
+// Local headers
+#include "countSnapshot.h"
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <limits>
+#include <cstring>
+
+const char CountSnapshot::magic[8] = { 'G', 'H', 'S', 'N', 'A', 'P', '\r', '\n' };
+
+bool CountSnapshot::Open(const std::string& fileName)
+{
+	Close();
+	if (!file.Open(fileName))
+		return false;
+
+	static_assert(sizeof(Header) == 32 && sizeof(Record) == 24, "Snapshot structures must be packed");
+
+	Header header;
+	if (file.GetSize() < sizeof(header))
+	{
+		std::cerr << "'" << fileName << "' is not a download count snapshot\n";
+		Close();
+		return false;
+	}
+
+	memcpy(&header, file.GetData(), sizeof(header));
+	if (memcmp(header.magic, magic, sizeof(magic)) != 0)
+	{
+		std::cerr << "'" << fileName << "' is not a download count snapshot\n";
+		Close();
+		return false;
+	}
+	else if (header.version != version)
+	{
+		std::cerr << "'" << fileName << "' has unsupported snapshot version " << header.version << '\n';
+		Close();
+		return false;
+	}
+
+	// Check the sections exactly fill the file (guarding against overflow in
+	// the size calculation)
+	const uint64_t maxCount(file.GetSize());
+	const uint64_t offsetsSize((static_cast<uint64_t>(header.stringCount) + 1) * sizeof(uint32_t));
+	const uint64_t recordsOffset(PadTo8(sizeof(header) + offsetsSize + header.stringDataSize));
+	if (header.stringDataSize > maxCount || header.recordCount > maxCount / sizeof(Record) ||
+		recordsOffset + header.recordCount * sizeof(Record) != file.GetSize())
+	{
+		std::cerr << "Download count snapshot '" << fileName << "' is truncated or corrupt\n";
+		Close();
+		return false;
+	}
+
+	stringOffsets = reinterpret_cast<const uint32_t*>(file.GetData() + sizeof(header));
+	stringData = file.GetData() + sizeof(header) + offsetsSize;
+	records = reinterpret_cast<const Record*>(file.GetData() + recordsOffset);
+	stringCount = header.stringCount;
+	stringDataSize = header.stringDataSize;
+	recordCount = header.recordCount;
+
+	return true;
+}
+
+void CountSnapshot::Close()
+{
+	file.Close();
+	stringOffsets = nullptr;
+	stringData = nullptr;
+	records = nullptr;
+	stringCount = 0;
+	stringDataSize = 0;
+	recordCount = 0;
+}
+
+std::string_view CountSnapshot::GetString(const uint32_t& i) const
+{
+	// Offsets are checked as they're used, since Open() doesn't scan the table
+	if (i >= stringCount || stringOffsets[i] > stringOffsets[i + 1] || stringOffsets[i + 1] > stringDataSize)
+		return std::string_view();
+	return std::string_view(stringData + stringOffsets[i], stringOffsets[i + 1] - stringOffsets[i]);
+}
+
+bool CountSnapshot::FindString(const std::string_view& s, uint32_t& i) const
+{
+	uint32_t low(0), high(stringCount);
+	while (low < high)
+	{
+		const uint32_t middle(low + (high - low) / 2);
+		if (GetString(middle) < s)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	i = low;
+	return low < stringCount && GetString(low) == s;
+}
+
+CountSnapshot::Entry CountSnapshot::GetEntry(const size_t& i) const
+{
+	Entry entry;
+	entry.repo = GetString(records[i].repo);
+	entry.tag = GetString(records[i].tag);
+	entry.asset = GetString(records[i].asset);
+	entry.count = records[i].count;
+	entry.flags = records[i].flags;
+	return entry;
+}
+
+bool CountSnapshot::Find(const std::string_view& repo, const std::string_view& tag,
+	const std::string_view& asset, Entry& entry) const
+{
+	uint32_t repoIndex, tagIndex, assetIndex;
+	if (!FindString(repo, repoIndex) || !FindString(tag, tagIndex) || !FindString(asset, assetIndex))
+		return false;
+
+	const auto key(std::make_tuple(repoIndex, tagIndex, assetIndex));
+	const Record* const end(records + recordCount);
+	const Record* r(std::lower_bound(records, end, key, [](const Record& a, const std::tuple<uint32_t, uint32_t, uint32_t>& b)
+	{
+		return std::tie(a.repo, a.tag, a.asset) < b;
+	}));
+
+	if (r == end || std::tie(r->repo, r->tag, r->asset) != key)
+		return false;
+
+	entry = GetEntry(r - records);
+	return true;
+}
+
+void CountSnapshot::GetRepoRange(const std::string_view& repo, size_t& begin, size_t& end) const
+{
+	uint32_t repoIndex;
+	if (!FindString(repo, repoIndex))
+	{
+		begin = end = 0;
+		return;
+	}
+
+	const Record* const last(records + recordCount);
+	begin = std::lower_bound(records, last, repoIndex, [](const Record& r, const uint32_t& index)
+	{
+		return r.repo < index;
+	}) - records;
+	end = std::upper_bound(records + begin, last, repoIndex, [](const uint32_t& index, const Record& r)
+	{
+		return index < r.repo;
+	}) - records;
+}
+
+void CountSnapshot::Merge(std::vector<Entry>& entries)
+{
+	// Stable, so that of any duplicates the last is the most recent
+	std::vector<size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&entries](const size_t& a, const size_t& b)
+	{
+		return std::tie(entries[a].repo, entries[a].tag, entries[a].asset)
+			< std::tie(entries[b].repo, entries[b].tag, entries[b].asset);
+	});
+
+	std::vector<Entry> merged;
+	std::vector<size_t> sequence;
+	merged.reserve(entries.size());
+	sequence.reserve(entries.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		const Entry& e(entries[order[i]]);
+		if (i + 1 < order.size())
+		{
+			const Entry& next(entries[order[i + 1]]);
+			if (e.repo == next.repo && e.tag == next.tag && e.asset == next.asset)
+				continue;
+		}
+
+		merged.push_back(e);
+		sequence.push_back(order[i]);
+	}
+
+	// Only the most recently counted asset of each release stays counted
+	for (size_t releaseBegin = 0, releaseEnd; releaseBegin < merged.size(); releaseBegin = releaseEnd)
+	{
+		size_t latest(merged.size());
+		for (releaseEnd = releaseBegin; releaseEnd < merged.size() &&
+			merged[releaseEnd].repo == merged[releaseBegin].repo &&
+			merged[releaseEnd].tag == merged[releaseBegin].tag; ++releaseEnd)
+		{
+			if ((merged[releaseEnd].flags & Counted) && (latest == merged.size() || sequence[releaseEnd] > sequence[latest]))
+				latest = releaseEnd;
+		}
+
+		for (size_t i = releaseBegin; i < releaseEnd; ++i)
+		{
+			if (i != latest)
+				merged[i].flags &= ~Counted;
+		}
+	}
+
+	entries.swap(merged);
+}
+
+bool CountSnapshot::Write(const std::string& fileName, const CountSnapshot* base, const std::vector<Entry>& updates)
+{
+	std::vector<Entry> entries;
+	const size_t baseCount(base ? base->GetRecordCount() : 0);
+	entries.reserve(baseCount + updates.size());
+	for (size_t i = 0; i < baseCount; ++i)
+		entries.push_back(base->GetEntry(i));
+	entries.insert(entries.end(), updates.begin(), updates.end());
+	Merge(entries);
+
+	std::vector<std::string_view> strings;
+	strings.reserve(entries.size() * 3);
+	for (const auto& e : entries)
+	{
+		strings.push_back(e.repo);
+		strings.push_back(e.tag);
+		strings.push_back(e.asset);
+	}
+	std::sort(strings.begin(), strings.end());
+	strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+
+	uint64_t stringDataSize(0);
+	for (const auto& s : strings)
+		stringDataSize += s.length();
+	if (stringDataSize > std::numeric_limits<uint32_t>::max() || strings.size() >= std::numeric_limits<uint32_t>::max())
+	{
+		std::cerr << "Too much data for a download count snapshot\n";
+		return false;
+	}
+
+	Header header;
+	memcpy(header.magic, magic, sizeof(magic));
+	header.version = version;
+	header.stringCount = static_cast<uint32_t>(strings.size());
+	header.recordCount = entries.size();
+	header.stringDataSize = stringDataSize;
+
+	const size_t offsetsSize((strings.size() + 1) * sizeof(uint32_t));
+	const size_t recordsOffset(PadTo8(sizeof(header) + offsetsSize + stringDataSize));
+	std::string buffer(recordsOffset + entries.size() * sizeof(Record), '\0');
+
+	memcpy(&buffer[0], &header, sizeof(header));
+	char* offsetPosition(&buffer[sizeof(header)]);
+	char* stringPosition(offsetPosition + offsetsSize);
+	uint32_t offset(0);
+	for (const auto& s : strings)
+	{
+		memcpy(offsetPosition, &offset, sizeof(offset));
+		offsetPosition += sizeof(offset);
+		memcpy(stringPosition + offset, s.data(), s.length());
+		offset += static_cast<uint32_t>(s.length());
+	}
+	memcpy(offsetPosition, &offset, sizeof(offset));
+
+	auto indexOf([&strings](const std::string_view& s)
+	{
+		return static_cast<uint32_t>(std::lower_bound(strings.begin(), strings.end(), s) - strings.begin());
+	});
+
+	char* recordPosition(&buffer[recordsOffset]);
+	for (const auto& e : entries)
+	{
+		Record r;
+		r.repo = indexOf(e.repo);
+		r.tag = indexOf(e.tag);
+		r.asset = indexOf(e.asset);
+		r.flags = e.flags;
+		r.count = e.count;
+		memcpy(recordPosition, &r, sizeof(r));
+		recordPosition += sizeof(r);
+	}
+
+	// The base may be mapped from fileName, so it's replaced rather than
+	// rewritten in place
+	return ReplaceDurably(fileName, buffer.data(), buffer.size());
+}
@@ -0,0 +1,107 @@
+// File:  countSnapshot.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Versioned binary snapshot of the most recent download count of each
+//        (repo, tag, asset).  The file is memory mapped and queried in place,
+//        so opening it costs the same regardless of how much it holds.
+
+#ifndef COUNT_SNAPSHOT_H_
+#define COUNT_SNAPSHOT_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Local headers
+#include "mappedFile.h"
+
+// File layout (host byte order):
+//   Header
+//   uint32_t stringOffsets[stringCount + 1]   offsets into the string data
+//   char stringData[stringDataSize]           sorted, unique, not terminated
+//   padding to a multiple of 8 bytes
+//   Record records[recordCount]               sorted by (repo, tag, asset)
+// Because the string table is sorted, ordering records by string index is the
+// same as ordering them by name.
+class CountSnapshot
+{
+public:
+	static constexpr uint32_t version = 1;
+
+	enum Flags : uint32_t
+	{
+		Counted = 1 << 0// Asset represents its release in download totals
+	};
+
+	struct Entry
+	{
+		std::string_view repo;
+		std::string_view tag;
+		std::string_view asset;
+		uint64_t count = 0;
+		uint32_t flags = 0;
+	};
+
+	// Only the header is read here; a missing file fails quietly
+	bool Open(const std::string& fileName);
+	void Close();
+	bool IsOpen() const { return file.IsOpen(); }
+
+	// Views returned by these point into the mapping and are valid until the
+	// snapshot is closed
+	size_t GetRecordCount() const { return recordCount; }
+	Entry GetEntry(const size_t& i) const;
+	uint64_t GetCount(const size_t& i) const { return records[i].count; }
+	uint32_t GetFlags(const size_t& i) const { return records[i].flags; }
+	bool Find(const std::string_view& repo, const std::string_view& tag,
+		const std::string_view& asset, Entry& entry) const;
+	void GetRepoRange(const std::string_view& repo, size_t& begin, size_t& end) const;
+
+	// Writes the contents of base (may be null or closed) with updates applied
+	// on top, via a synced temporary file that replaces fileName once complete
+	static bool Write(const std::string& fileName, const CountSnapshot* base, const std::vector<Entry>& updates);
+
+	// Sorts entries (given oldest first) by (repo, tag, asset), keeping the
+	// newest of any duplicates.  Within each release only the newest counted
+	// entry keeps its Counted flag.
+	static void Merge(std::vector<Entry>& entries);
+
+private:
+	struct Header
+	{
+		char magic[8];
+		uint32_t version;
+		uint32_t stringCount;
+		uint64_t recordCount;
+		uint64_t stringDataSize;
+	};
+
+	struct Record
+	{
+		uint32_t repo;
+		uint32_t tag;
+		uint32_t asset;
+		uint32_t flags;
+		uint64_t count;
+	};
+
+	static const char magic[8];
+
+	MappedFile file;
+	const uint32_t* stringOffsets = nullptr;
+	const char* stringData = nullptr;
+	const Record* records = nullptr;
+	uint32_t stringCount = 0;
+	size_t stringDataSize = 0;
+	size_t recordCount = 0;
+
+	std::string_view GetString(const uint32_t& i) const;
+	bool FindString(const std::string_view& s, uint32_t& i) const;
+
+	static size_t PadTo8(const size_t& size) { return (size + 7) & ~static_cast<size_t>(7); }
+};
+
+#endif// COUNT_SNAPSHOT_H_
@@ -0,0 +1,158 @@
+// File:  countStore.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download count snapshot with a write-ahead log in front of it.
+//        Changes are appended (and synced) to the log, which is folded into
+//        the snapshot once it grows large, so each run only pays for what
+//        changed and a crash never loses the baseline.
+
+// Local headers
+#include "countStore.h"
+#include "timestamp.h"
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+
+bool CountStore::Open(const std::string& snapshotFile, const std::string& logFile)
+{
+	Close();
+	snapshotFileName = snapshotFile;
+	logFileName = logFile;
+
+	std::error_code error;
+	if (!snapshot.Open(snapshotFileName) && std::filesystem::exists(snapshotFileName, error))
+		return false;
+
+	isOpen = ReadLog();
+	return isOpen;
+}
+
+bool CountStore::ReadLog()
+{
+	log.Close();
+	pending.clear();
+
+	std::error_code error;
+	if (!log.Open(logFileName))
+		return !std::filesystem::exists(logFileName, error);
+
+	int64_t time;
+	std::vector<CountHistory::Sample> samples;
+	while (log.NextBatch(time, samples))
+	{
+		for (const auto& sample : samples)
+			pending.push_back({ sample.repo, sample.tag, sample.asset, sample.count, sample.flags });
+	}
+
+	if (log.HasDamage())
+		std::cerr << "Skipped damaged entries in '" << logFileName << "'\n";
+
+	SortPending();
+	return true;
+}
+
+void CountStore::Close()
+{
+	isOpen = false;
+	snapshot.Close();
+	log.Close();
+	pending.clear();
+}
+
+void CountStore::SortPending()
+{
+	std::stable_sort(pending.begin(), pending.end(), [](const CountSnapshot::Entry& a, const CountSnapshot::Entry& b)
+	{
+		return a.repo < b.repo;
+	});
+}
+
+void CountStore::GetRepoEntries(const std::string_view& repo, std::vector<CountSnapshot::Entry>& entries) const
+{
+	entries.clear();
+
+	size_t begin, end;
+	snapshot.GetRepoRange(repo, begin, end);
+	for (size_t i = begin; i < end; ++i)
+		entries.push_back(snapshot.GetEntry(i));
+
+	const auto logged(std::equal_range(pending.begin(), pending.end(), CountSnapshot::Entry({ repo, {}, {}, 0, 0 }),
+		[](const CountSnapshot::Entry& a, const CountSnapshot::Entry& b)
+	{
+		return a.repo < b.repo;
+	}));
+
+	if (logged.first == logged.second)
+		return;
+
+	entries.insert(entries.end(), logged.first, logged.second);
+	CountSnapshot::Merge(entries);
+}
+
+bool CountStore::Update(const std::vector<CountSnapshot::Entry>& changes)
+{
+	if (!isOpen)
+		return false;
+	else if (changes.empty())
+		return true;
+
+	std::vector<CountHistory::Sample> samples;
+	samples.reserve(changes.size());
+	for (const auto& change : changes)
+		samples.push_back({ change.repo, change.tag, change.asset, change.count, change.flags });
+
+	if (!CountHistory::Append(logFileName, Timestamp::Now().GetSeconds(), samples))
+		return false;
+
+	pending.insert(pending.end(), changes.begin(), changes.end());
+	SortPending();
+
+	std::error_code error;
+	const uintmax_t logSize(std::filesystem::file_size(logFileName, error));
+	if (!error && logSize > foldSize)
+		return Fold();
+
+	return true;
+}
+
+bool CountStore::Fold()
+{
+	if (!isOpen)
+		return false;
+	else if (pending.empty())
+		return true;
+
+	// Held until the log is gone, so no append lands between reading the log
+	// and removing it.  Both files are read again under the lock, in case
+	// another process appended or folded since they were opened.
+	const FileLock lock(logFileName);
+	if (!lock.IsLocked())
+		return false;
+
+	std::error_code error;
+	isOpen = (snapshot.Open(snapshotFileName) || !std::filesystem::exists(snapshotFileName, error)) && ReadLog();
+	if (!isOpen)
+		return false;
+	else if (pending.empty())
+		return true;
+
+	// The log is only removed once the new snapshot is in place; if that
+	// doesn't happen, replaying it next time gives the same result
+	if (!CountSnapshot::Write(snapshotFileName, &snapshot, pending))
+		return false;
+
+	pending.clear();
+	log.Close();
+	std::filesystem::remove(logFileName, error);
+	if (error)
+	{
+		std::cerr << "Failed to remove '" << logFileName << "':  " << error.message() << '\n';
+		return false;
+	}
+
+	isOpen = snapshot.Open(snapshotFileName);
+	return isOpen;
+}
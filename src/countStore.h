@@ -0,0 +1,62 @@
+// File:  countStore.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Download count snapshot with a write-ahead log in front of it.
+//        Changes are appended (and synced) to the log, which is folded into
+//        the snapshot once it grows large, so each run only pays for what
+//        changed and a crash never loses the baseline.
+
+#ifndef COUNT_STORE_H_
+#define COUNT_STORE_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Local headers
+#include "countSnapshot.h"
+#include "countHistory.h"
+
+class CountStore
+{
+public:
+	// Missing files are treated as empty; fails if an existing file can't be
+	// read
+	bool Open(const std::string& snapshotFileName, const std::string& logFileName);
+	void Close();
+	bool IsOpen() const { return isOpen; }
+
+	// The entries of a repo, sorted by (tag, asset), with logged changes
+	// applied.  Views are valid until the store is closed or updated.
+	void GetRepoEntries(const std::string_view& repo, std::vector<CountSnapshot::Entry>& entries) const;
+
+	// Logs the changes (which must outlive the store), folding the log into
+	// the snapshot once it exceeds foldSize.  Fails if the store isn't open, so
+	// files that couldn't be read are never overwritten.
+	bool Update(const std::vector<CountSnapshot::Entry>& changes);
+
+	// Rewrites the snapshot with the logged changes applied (via a temporary
+	// file and rename), then discards the log.  Holds the log's lock
+	// throughout, so must not be called while the caller holds it.
+	bool Fold();
+
+	static constexpr size_t foldSize = 1024 * 1024;
+
+private:
+	std::string snapshotFileName;
+	std::string logFileName;
+	bool isOpen = false;
+
+	CountSnapshot snapshot;
+	CountHistory log;
+
+	// Logged changes, grouped by repo but otherwise oldest first
+	std::vector<CountSnapshot::Entry> pending;
+
+	// Replaces pending with the contents of the log; a missing log is empty
+	bool ReadLog();
+	void SortPending();
+};
+
+#endif// COUNT_STORE_H_
@@ -0,0 +1,214 @@
+// File:  durableWrite.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  File writes that are flushed to stable storage before returning, and
+//        an advisory lock for files shared between processes.
+
+// Local headers
+#include "durableWrite.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif// WIN32_LEAN_AND_MEAN
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif// NOMINMAX
+#include <Windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+// *nix headers
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <cerrno>
+#endif// _WIN32
+
+#ifdef _WIN32
+
+static int OpenForWrite(const std::string& fileName, const int& flags)
+{
+	return _open(fileName.c_str(), flags | _O_WRONLY | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+static bool WriteAll(const int& fd, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		const unsigned int chunk(static_cast<unsigned int>(std::min<size_t>(size, 1 << 30)));
+		const int written(_write(fd, data, chunk));
+		if (written <= 0)
+			return false;
+		data += written;
+		size -= written;
+	}
+	return true;
+}
+
+static bool Sync(const int& fd) { return _commit(fd) == 0; }
+static void CloseFile(const int& fd) { _close(fd); }
+static const int appendFlag(_O_APPEND);
+static const int truncateFlag(_O_TRUNC);
+
+static bool SyncDirectory(const std::string&)
+{
+	return true;// MoveFileEx with MOVEFILE_WRITE_THROUGH covers this
+}
+
+static bool Lock(const int& fd)
+{
+	OVERLAPPED overlapped = {};
+	return LockFileEx(reinterpret_cast<HANDLE>(_get_osfhandle(fd)), LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &overlapped) != 0;
+}
+
+static int OpenForLock(const std::string& fileName)
+{
+	return _open(fileName.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+}
+
+static bool Rename(const std::string& from, const std::string& to)
+{
+	return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else
+
+static int OpenForWrite(const std::string& fileName, const int& flags)
+{
+	return open(fileName.c_str(), flags | O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+}
+
+static bool WriteAll(const int& fd, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		const ssize_t written(write(fd, data, size));
+		if (written < 0 && errno == EINTR)
+			continue;
+		else if (written <= 0)
+			return false;
+		data += written;
+		size -= written;
+	}
+	return true;
+}
+
+static bool Sync(const int& fd) { return fsync(fd) == 0; }
+static void CloseFile(const int& fd) { close(fd); }
+static const int appendFlag(O_APPEND);
+static const int truncateFlag(O_TRUNC);
+
+// Makes a rename (or the creation of a file) durable
+static bool SyncDirectory(const std::string& fileName)
+{
+	std::string directory(std::filesystem::path(fileName).parent_path().string());
+	if (directory.empty())
+		directory = ".";
+
+	const int fd(open(directory.c_str(), O_RDONLY | O_CLOEXEC));
+	if (fd < 0)
+		return false;
+	const bool success(fsync(fd) == 0);
+	close(fd);
+	return success;
+}
+
+static bool Lock(const int& fd)
+{
+	while (flock(fd, LOCK_EX) != 0)
+	{
+		if (errno != EINTR)
+			return false;
+	}
+	return true;
+}
+
+static int OpenForLock(const std::string& fileName)
+{
+	return open(fileName.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+}
+
+static bool Rename(const std::string& from, const std::string& to)
+{
+	return rename(from.c_str(), to.c_str()) == 0;
+}
+
+#endif// _WIN32
+
+bool AppendDurably(const std::string& fileName, const char* data, const size_t& size)
+{
+	std::error_code error;
+	const bool existed(std::filesystem::exists(fileName, error));
+	const int fd(OpenForWrite(fileName, appendFlag));
+	if (fd < 0)
+	{
+		std::cerr << "Failed to open '" << fileName << "' for output\n";
+		return false;
+	}
+
+	const bool success(WriteAll(fd, data, size) && Sync(fd));
+	CloseFile(fd);
+	if (!success)
+	{
+		std::cerr << "Failed to append to '" << fileName << "'\n";
+		return false;
+	}
+
+	return existed || SyncDirectory(fileName);
+}
+
+bool ReplaceDurably(const std::string& fileName, const char* data, const size_t& size)
+{
+	const std::string tempFileName(fileName + ".tmp");
+	const int fd(OpenForWrite(tempFileName, truncateFlag));
+	if (fd < 0)
+	{
+		std::cerr << "Failed to open '" << tempFileName << "' for output\n";
+		return false;
+	}
+
+	std::error_code error;
+	const bool success(WriteAll(fd, data, size) && Sync(fd));
+	CloseFile(fd);
+	if (!success)
+	{
+		std::cerr << "Failed to write '" << tempFileName << "'\n";
+		std::filesystem::remove(tempFileName, error);
+		return false;
+	}
+
+	if (!Rename(tempFileName, fileName))
+	{
+		std::cerr << "Failed to replace '" << fileName << "'\n";
+		std::filesystem::remove(tempFileName, error);
+		return false;
+	}
+
+	return SyncDirectory(fileName);
+}
+
+FileLock::FileLock(const std::string& fileName) : fd(OpenForLock(fileName + ".lock"))
+{
+	if (fd >= 0 && !Lock(fd))
+	{
+		CloseFile(fd);
+		fd = -1;
+	}
+
+	if (fd < 0)
+		std::cerr << "Failed to lock '" << fileName << "'\n";
+}
+
+// Closing the file releases the lock
+FileLock::~FileLock()
+{
+	if (fd >= 0)
+		CloseFile(fd);
+}
@@ -0,0 +1,40 @@
+// File:  durableWrite.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  File writes that are flushed to stable storage before returning, and
+//        an advisory lock for files shared between processes.
+
+#ifndef DURABLE_WRITE_H_
+#define DURABLE_WRITE_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstddef>
+
+// Appends the data with a single write followed by a single sync, creating the
+// file if necessary
+bool AppendDurably(const std::string& fileName, const char* data, const size_t& size);
+
+// Writes the data to a temporary file, syncs it and renames it over fileName,
+// so readers see either the old contents or the new, never a mix
+bool ReplaceDurably(const std::string& fileName, const char* data, const size_t& size);
+
+// Exclusive lock on fileName + ".lock", held for the object's lifetime.  A
+// separate file is locked because ReplaceDurably() swaps in a new file (and
+// the lock would stay with the old one).  Blocks until the lock is acquired.
+class FileLock
+{
+public:
+	explicit FileLock(const std::string& fileName);
+	~FileLock();
+
+	FileLock(const FileLock&) = delete;
+	FileLock& operator=(const FileLock&) = delete;
+
+	bool IsLocked() const { return fd >= 0; }
+
+private:
+	int fd;
+};
+
+#endif// DURABLE_WRITE_H_
@@ -5,34 +5,80 @@
 
 // Local headers
 #include "gitHubInterface.h"
-#include "cJSON.h"
+#include "jsonDecoder.h"
+#include "assetTable.h"
+#include "assetClassifier.h"
 
 // cURL headers
 #include <curl/curl.h>
 
 // Standard C++ headers
 #include <iostream>
-#include <sstream>
+#include <charconv>
 
 const std::string GitHubInterface::apiRoot("https://api.github.com/");
 
-const std::string GitHubInterface::userURLTag("user_url");
-const std::string GitHubInterface::userReposURLTag("repository_url");
+// Small response payloads used only during initialization
+struct APIRootLinks
+{
+	std::string userURL;
+	std::string repositoryURL;
+};
+
+struct UserLinks
+{
+	std::string reposURL;
+	unsigned int repoCount = 0;
+};
 
-const std::string GitHubInterface::reposURLTag("repos_url");
-const std::string GitHubInterface::nameTag("name");
-const std::string GitHubInterface::repoCountTag("public_repos");
-const std::string GitHubInterface::creationTimeTag("created_at");
+template<>
+struct JSONSchema<APIRootLinks>
+{
+	static constexpr auto fields = std::make_tuple(
+		MakeJSONField(GitHubInterface::userURLTag, &APIRootLinks::userURL),
+		MakeJSONField(GitHubInterface::userReposURLTag, &APIRootLinks::repositoryURL));
+};
 
-const std::string GitHubInterface::descriptionTag("description");
-const std::string GitHubInterface::releasesURLTag("releases_url");
-const std::string GitHubInterface::updateTimeTag("updated_at");
-const std::string GitHubInterface::languageTag("language");
+template<>
+struct JSONSchema<UserLinks>
+{
+	static constexpr auto fields = std::make_tuple(
+		MakeJSONField(GitHubInterface::reposURLTag, &UserLinks::reposURL),
+		MakeJSONField(GitHubInterface::repoCountTag, &UserLinks::repoCount));
+};
 
-const std::string GitHubInterface::tagNameTag("tag_name");
-const std::string GitHubInterface::assetTag("assets");
-const std::string GitHubInterface::sizeTag("size");
-const std::string GitHubInterface::downloadCountTag("download_count");
+template<>
+struct JSONSchema<GitHubInterface::RepoInfo>
+{
+	typedef GitHubInterface::RepoInfo RepoInfo;
+	static constexpr auto fields = std::make_tuple(
+		MakeJSONField(GitHubInterface::nameTag, &RepoInfo::name),
+		MakeJSONField(GitHubInterface::descriptionTag, &RepoInfo::description),
+		MakeJSONField(GitHubInterface::updateTimeTag, &RepoInfo::lastUpdateTime),
+		MakeJSONField(GitHubInterface::creationTimeTag, &RepoInfo::creationTime),
+		MakeJSONField(GitHubInterface::languageTag, &RepoInfo::language),
+		MakeJSONField(GitHubInterface::releasesURLTag, &RepoInfo::releasesURL));
+};
+
+template<>
+struct JSONSchema<GitHubInterface::AssetData>
+{
+	typedef GitHubInterface::AssetData AssetData;
+	static constexpr auto fields = std::make_tuple(
+		MakeJSONField(GitHubInterface::nameTag, &AssetData::name),
+		MakeJSONField(GitHubInterface::sizeTag, &AssetData::fileSize),
+		MakeJSONField(GitHubInterface::downloadCountTag, &AssetData::downloadCount));
+};
+
+template<>
+struct JSONSchema<GitHubInterface::ReleaseData>
+{
+	typedef GitHubInterface::ReleaseData ReleaseData;
+	static constexpr auto fields = std::make_tuple(
+		MakeJSONField(GitHubInterface::tagNameTag, &ReleaseData::tag),
+		MakeJSONField(GitHubInterface::creationTimeTag, &ReleaseData::creationTime),
+		MakeJSONField(GitHubInterface::assetTag, &ReleaseData::assets));
+};
 
 GitHubInterface::GitHubInterface(const std::string &userAgent,
 	const std::string& token)
@@ -52,18 +98,18 @@ bool GitHubInterface::Initialize(const std::string& user)
 	if (!DoCURLGet(apiRoot, response, &GitHubInterface::AddCurlAuthentication, &authData))
 		return false;
 
-	cJSON *root = cJSON_Parse(response.c_str());
-	if (!root)
+	APIRootLinks links;
+	if (!DecodeJSON(response, links))
 	{
 		std::cerr << "Failed to parse returned string (Initialize())" << std::endl;
 		std::cerr << response << std::endl;
 		return false;
 	}
 
-	userURL.clear();
-	reposURLRoot.clear();
+	userURL = links.userURL;
+	reposURLRoot = links.repositoryURL;
 
-	if (ReadJSON(root, userURLTag, userURL))
+	if (!userURL.empty())
 	{
 		const std::string userCode("{user}");
 		size_t begin(userURL.find(userCode));
@@ -73,7 +119,7 @@ bool GitHubInterface::Initialize(const std::string& user)
 			userURL.replace(begin, userCode.length(), user);
 	}
 
-	if (ReadJSON(root, userReposURLTag, reposURLRoot))
+	if (!reposURLRoot.empty())
 	{
 		const std::string ownerCode("{owner}");
 		size_t begin(reposURLRoot.find(ownerCode));
@@ -91,87 +137,178 @@ bool GitHubInterface::Initialize(const std::string& user)
 		}
 	}
 
-	cJSON_Delete(root);
-
 	return !userURL.empty() && !reposURLRoot.empty();
 }
 
 std::vector<GitHubInterface::RepoInfo> GitHubInterface::GetUsersRepos()
 {
 	std::vector<RepoInfo> repos;
+	size_t expectedCount(0);
+	GetUsersRepos([&repos, &expectedCount](RepoInfo& info)
+	{
+		if (repos.empty())
+			repos.reserve(expectedCount);
+		repos.push_back(std::move(info));
+	}, expectedCount);
+
+	return repos;
+}
+
+bool GitHubInterface::GetUsersRepos(const RepoCallback& callback)
+{
+	size_t expectedCount;
+	return GetUsersRepos(callback, expectedCount);
+}
 
+bool GitHubInterface::GetUsersRepos(const RepoCallback& callback, size_t& expectedCount)
+{
 	std::string response;
 	if (!DoCURLGet(userURL, response, &GitHubInterface::AddCurlAuthentication, &authData))
-		return repos;
+		return false;
 
-	cJSON *root = cJSON_Parse(response.c_str());
-	if (!root)
+	UserLinks links;
+	if (!DecodeJSON(response, links))
 	{
 		std::cerr << "Failed to parse returned string (GetUsersRepos())" << std::endl;
 		std::cerr << response << std::endl;
-		return repos;
+		return false;
 	}
 
-	std::string reposURL;
-	if (!ReadJSON(root, reposURLTag, reposURL))
+	if (links.reposURL.empty())
 	{
 		std::cerr << "Failed to find repository access in response" << std::endl;
-		return repos;
+		return false;
 	}
+	expectedCount = links.repoCount;
 
-	cJSON_Delete(root);
+	JSONRecordStream<RepoInfo> stream([&callback](RepoInfo& info)
+	{
+		TrimReleasesURL(info);
+		callback(info);
+	});
+	JSONEventParser parser(stream);
 
 	unsigned int page(1);
+	std::string pageURL;
 	while (true)
 	{
-		if (!DoCURLGet(AppendPageToURL(reposURL, page++), response, &GitHubInterface::AddCurlAuthentication, &authData))
-			return repos;
-
-		root = cJSON_Parse(response.c_str());
-
-		const int count(cJSON_GetArraySize(root));
-		if (count == 0)
-			break;
-
-		for (int i = 0; i < count; i++)
+		const size_t previousCount(stream.GetRecordCount());
+		BuildPageURL(links.reposURL, page++, pageURL);
+		if (!DoCURLGet(pageURL, parser, &GitHubInterface::AddCurlAuthentication, &authData))
 		{
-			cJSON* repo = cJSON_GetArrayItem(root, i);
-			repos.push_back(GetRepoData(repo));
+			if (parser.HasError())
+				std::cerr << "Failed to parse returned string (GetUsersRepos()):  "
+					<< GetJSONParseErrorString(parser.GetError()) << " at offset " << parser.GetErrorOffset() << std::endl;
+			return false;
 		}
 
-		cJSON_Delete(root);
+		if (stream.GetRecordCount() == previousCount)
+			break;
 	}
 
-	return repos;
+	return true;
 }
 
-std::string GitHubInterface::AppendPageToURL(const std::string& root, const unsigned int& page)
+void GitHubInterface::BuildPageURL(const std::string& root, const unsigned int& page, std::string& url)
 {
-	std::ostringstream ss;
-	ss << root << "?page=" << page;
-	return ss.str();
+	const char pageArgument[] = "?page=";
+	char digits[16];
+	const char* digitsEnd(std::to_chars(digits, digits + sizeof(digits), page).ptr);
+
+	url.assign(root);
+	url.append(pageArgument, sizeof(pageArgument) - 1);
+	url.append(digits, digitsEnd - digits);
+}
+
+bool GitHubInterface::DecodeRepos(const std::string& response, std::vector<RepoInfo>& repos)
+{
+	const size_t firstNew(repos.size());
+	if (!DecodeJSON(response, repos))
+		return false;
+
+	for (size_t i = firstNew; i < repos.size(); ++i)
+		TrimReleasesURL(repos[i]);
+
+	return true;
 }
 
-GitHubInterface::RepoInfo GitHubInterface::GetRepoData(cJSON* repoNode)
+bool GitHubInterface::DecodeRepos(const std::string& response, const RepoCallback& callback)
 {
-	RepoInfo info;
-
-	ReadJSON(repoNode, nameTag, info.name);
-	ReadJSON(repoNode, descriptionTag, info.description);
-	ReadJSON(repoNode, updateTimeTag, info.lastUpdateTime);
-	ReadJSON(repoNode, creationTimeTag, info.creationTime);
-	ReadJSON(repoNode, languageTag, info.language);
-	if (ReadJSON(repoNode, releasesURLTag, info.releasesURL))
+	JSONRecordStream<RepoInfo> stream([&callback](RepoInfo& info)
 	{
-		const std::string idCode("{/id}");
-		size_t begin(info.releasesURL.find(idCode));
-		if (begin == std::string::npos)
-			info.releasesURL.clear();
-		else
-			info.releasesURL.resize(begin);
+		TrimReleasesURL(info);
+		callback(info);
+	});
+	JSONEventParser parser(stream);
+	return parser.Parse(response) && parser.Finish();
+}
+
+void GitHubInterface::TrimReleasesURL(RepoInfo& info)
+{
+	const std::string idCode("{/id}");
+	size_t begin(info.releasesURL.find(idCode));
+	if (begin == std::string::npos)
+		info.releasesURL.clear();
+	else
+		info.releasesURL.resize(begin);
+}
+
+bool GitHubInterface::DecodeReleases(const std::string& response, std::vector<ReleaseData>& releases)
+{
+	// Release pages are large and mostly made up of fields we ignore (body,
+	// author, uploader), so these go through the tape where skipping is free.
+	// Each thread keeps its tape so the entry buffer is reused across pages.
+	thread_local JSONTape tape;
+	if (!tape.Parse(response) || !DecodeJSON(tape, releases))
+		return false;
+
+	for (auto& release : releases)
+		ClassifyAssets(release);
+	return true;
+}
+
+void GitHubInterface::ClassifyAssets(ReleaseData& release)
+{
+	for (auto& asset : release.assets)
+		asset.priority = AssetClassifier::Get().Classify(asset.name);
+}
+
+bool GitHubInterface::DecodeReleases(const std::string& response, const uint32_t& repo, AssetTable& assets)
+{
+	thread_local JSONTape tape;
+	if (!tape.Parse(response) || !tape.GetRoot().Is(JSONTape::Type::Array))
+		return false;
+
+	// Size the columns once from the array lengths on the tape
+	const JSONTapeNode root(tape.GetRoot());
+	size_t rowCount(0);
+	for (JSONTapeNode element(root.GetFirstChild()); element.IsValid(); element = element.GetNext())
+		rowCount += element.GetMember(assetTag, sizeof(assetTag) - 1).GetSize();
+	assets.Reserve(assets.GetReleaseCount() + root.GetSize(), assets.GetRowCount() + rowCount);
+
+	for (JSONTapeNode element(root.GetFirstChild()); element.IsValid(); element = element.GetNext())
+	{
+		InternedString tag;
+		Timestamp creationTime;
+		if (!ReadJSONValue(element.GetMember(tagNameTag, sizeof(tagNameTag) - 1), tag) ||
+			!ReadJSONValue(element.GetMember(creationTimeTag, sizeof(creationTimeTag) - 1), creationTime))
+			return false;
+		assets.AddRelease(repo, tag, creationTime.GetSeconds());
+
+		const JSONTapeNode assetList(element.GetMember(assetTag, sizeof(assetTag) - 1));
+		for (JSONTapeNode asset(assetList.GetFirstChild()); asset.IsValid(); asset = asset.GetNext())
+		{
+			InternedString name;
+			uint64_t size(0), downloadCount(0);
+			if (!ReadJSONValue(asset.GetMember(nameTag, sizeof(nameTag) - 1), name) ||
+				!ReadJSONValue(asset.GetMember(sizeTag, sizeof(sizeTag) - 1), size) ||
+				!ReadJSONValue(asset.GetMember(downloadCountTag, sizeof(downloadCountTag) - 1), downloadCount))
+				return false;
+			assets.AddAsset(name, size, downloadCount, AssetClassifier::Get().Classify(name));
+		}
 	}
 
-	return info;
+	return true;
 }
 
 bool GitHubInterface::AddCurlAuthentication(CURL* curl, const ModificationData* data)
@@ -223,70 +360,141 @@ bool GitHubInterface::GetRepoData(RepoInfo& info,
 		return true;
 
 	releaseData->clear();
+	return GetRepoData(info, [releaseData](ReleaseData& release)
+	{
+		releaseData->push_back(std::move(release));
+	});
+}
 
+bool GitHubInterface::GetRepoData(RepoInfo& info, const ReleaseCallback& callback)
+{
 	std::string response;
 	if (!DoCURLGet(info.releasesURL, response, &GitHubInterface::AddCurlAuthentication, &authData))
 		return false;
 
-	cJSON *root = cJSON_Parse(response.c_str());
-	if (!root)
+	JSONTape tape;
+	if (!tape.Parse(response))
+	{
+		std::cerr << "Failed to parse returned string (GetRepoData()):  "
+			<< GetJSONParseErrorString(tape.GetError()) << " at offset " << tape.GetErrorOffset() << std::endl;
+		return false;
+	}
+	else if (!tape.GetRoot().Is(JSONTape::Type::Array))
 	{
 		std::cerr << "Failed to parse returned string (GetRepoData())" << std::endl;
 		std::cerr << response << std::endl;
 		return false;
 	}
 
-	const int count(cJSON_GetArraySize(root));
-	info.hasReleases = count > 0;
-	int i;
-	for (i = 0; i < count; i++)
+	const JSONTapeNode root(tape.GetRoot());
+	ReleaseData release;
+	for (JSONTapeNode element(root.GetFirstChild()); element.IsValid(); element = element.GetNext())
 	{
-		cJSON* release = cJSON_GetArrayItem(root, i);
-		releaseData->push_back(GetReleaseData(release));
+		ResetJSONValue(release);
+		if (!ReadJSONValue(element, release))
+		{
+			std::cerr << "Failed to parse returned string (GetRepoData())" << std::endl;
+			return false;
+		}
+		ClassifyAssets(release);
+		callback(release);
 	}
 
-	cJSON_Delete(root);
+	info.hasReleases = root.GetSize() > 0;
 
 	return true;
 }
 
-GitHubInterface::ReleaseData GitHubInterface::GetReleaseData(cJSON* releaseNode)
+bool GitHubInterface::GetRepoData(std::vector<RepoInfo>& repos,
+	std::vector<std::vector<ReleaseData>>& releaseData)
 {
-	ReleaseData r;
-
-	ReadJSON(releaseNode, tagNameTag, r.tag);
-	ReadJSON(releaseNode, creationTimeTag, r.creationTime);
-
-	cJSON* assetNode = cJSON_GetObjectItem(releaseNode, assetTag.c_str());
-	if (!assetNode)
-		return r;
+	// Each task only touches its own slot, and the slots are sized up front so
+	// nothing moves while the workers are running
+	std::vector<std::string> responses(repos.size());
+	std::vector<char> fetched(repos.size(), false);
+	std::vector<char> decoded(repos.size(), false);
+	releaseData.clear();
+	releaseData.resize(repos.size());
+
+	bool success(true);
+	for (size_t i = 0; i < repos.size(); ++i)
+	{
+		if (!DoCURLGet(repos[i].releasesURL, responses[i], &GitHubInterface::AddCurlAuthentication, &authData))
+		{
+			success = false;
+			continue;
+		}
+		fetched[i] = true;
 
-	const int count(cJSON_GetArraySize(assetNode));
+		parsePool.Submit([&responses, &releaseData, &decoded, i]()
+		{
+			decoded[i] = DecodeReleases(responses[i], releaseData[i]);
+			std::string().swap(responses[i]);// Release the body as soon as it's done with
+		});
+	}
+	parsePool.Wait();
 
-	int i;
-	for (i = 0; i < count; i++)
+	for (size_t i = 0; i < repos.size(); ++i)
 	{
-		cJSON* asset = cJSON_GetArrayItem(assetNode, i);
-		r.assets.push_back(GetAssetData(asset));
+		if (fetched[i] && !decoded[i])
+		{
+			std::cerr << "Failed to parse releases for '" << repos[i].name << "' (GetRepoData())" << std::endl;
+			success = false;
+		}
+		repos[i].hasReleases = !releaseData[i].empty();
 	}
 
-	return r;
+	return success;
 }
 
-GitHubInterface::AssetData GitHubInterface::GetAssetData(cJSON* assetNode)
+bool GitHubInterface::GetRepoData(std::vector<RepoInfo>& repos, AssetTable& assets)
 {
-	AssetData info;
+	// Each repo is decoded into its own table, then the tables are joined in
+	// repo order
+	std::vector<std::string> responses(repos.size());
+	std::vector<AssetTable> tables(repos.size());
+	std::vector<char> fetched(repos.size(), false);
+	std::vector<char> decoded(repos.size(), false);
+
+	bool success(true);
+	for (size_t i = 0; i < repos.size(); ++i)
+	{
+		if (!DoCURLGet(repos[i].releasesURL, responses[i], &GitHubInterface::AddCurlAuthentication, &authData))
+		{
+			success = false;
+			continue;
+		}
+		fetched[i] = true;
 
-	ReadJSON(assetNode, nameTag, info.name);
-	ReadJSON(assetNode, sizeTag, info.fileSize);
-	ReadJSON(assetNode, downloadCountTag, info.downloadCount);
+		parsePool.Submit([&responses, &tables, &decoded, i]()
+		{
+			decoded[i] = DecodeReleases(responses[i], 0, tables[i]);
+			std::string().swap(responses[i]);
+		});
+	}
+	parsePool.Wait();
 
-	return info;
-}
+	size_t releaseCount(0), rowCount(0);
+	for (const auto& table : tables)
+	{
+		releaseCount += table.GetReleaseCount();
+		rowCount += table.GetRowCount();
+	}
+	assets.Clear();
+	assets.Reserve(releaseCount, rowCount);
 
-bool GitHubInterface::IsBestAsset(const std::string& name)
-{
-	if (name.length() > 4 && name.substr(name.length() - 4).compare(".exe") == 0)// TODO:  Handle uppercase, too
-		return true;
-	return false;
+	for (size_t i = 0; i < repos.size(); ++i)
+	{
+		if (fetched[i] && !decoded[i])
+		{
+			std::cerr << "Failed to parse releases for '" << repos[i].name << "' (GetRepoData())" << std::endl;
+			success = false;
+		}
+		else
+			assets.Append(static_cast<uint32_t>(i), tables[i]);
+		repos[i].hasReleases = assets.GetReleaseCount(static_cast<uint32_t>(i)) > 0;
+		tables[i].Release();
+	}
+
+	return success;
 }
@@ -8,9 +8,15 @@
 
 // Standard C++ headers
 #include <vector>
+#include <functional>
 
 // Local headers
 #include "jsonInterface.h"
+#include "parsePool.h"
+#include "stringInterner.h"
+#include "timestamp.h"
+
+class AssetTable;
 
 class GitHubInterface : public JSONInterface
 {
@@ -23,27 +29,28 @@ public:
 
 	struct RepoInfo
 	{
-		std::string name;
+		InternedString name;
 		std::string description;
 		std::string releasesURL;
-		std::string creationTime;
-		std::string lastUpdateTime;
-		std::string language;
+		Timestamp creationTime;
+		Timestamp lastUpdateTime;
+		InternedString language;
 
-		bool hasReleases;
+		bool hasReleases = false;
 	};
 
 	struct AssetData
 	{
-		std::string name;
-		unsigned int fileSize;
-		unsigned int downloadCount;
+		InternedString name;
+		uint64_t fileSize = 0;
+		uint64_t downloadCount = 0;
+		uint8_t priority = 0;// Set by AssetClassifier when decoded
 	};
 
 	struct ReleaseData
 	{
-		std::string tag;
-		std::string creationTime;
+		InternedString tag;
+		Timestamp creationTime;
 		std::vector<AssetData> assets;
 	};
 
@@ -51,38 +58,57 @@ public:
 	bool GetRepoData(GitHubInterface::RepoInfo& info,
 		std::vector<ReleaseData>* releaseData = NULL);
 
-	static bool IsBestAsset(const std::string& name);
+	// Streaming versions - each record is passed to the callback (which may
+	// move from it) as soon as it has been received
+	typedef std::function<void(RepoInfo&)> RepoCallback;
+	typedef std::function<void(ReleaseData&)> ReleaseCallback;
+	bool GetUsersRepos(const RepoCallback& callback);
+	bool GetRepoData(RepoInfo& info, const ReleaseCallback& callback);
+
+	// Fetches the releases for every repo, decoding each response on the parse
+	// pool while the next is transferred; releaseData[i] belongs to repos[i]
+	bool GetRepoData(std::vector<RepoInfo>& repos,
+		std::vector<std::vector<ReleaseData>>& releaseData);
+
+	// As above, but appends straight to a columnar table (repo ids are indices
+	// into repos)
+	bool GetRepoData(std::vector<RepoInfo>& repos, AssetTable& assets);
+
+	// Decode raw API responses (arrays of repos or releases)
+	static bool DecodeRepos(const std::string& response, std::vector<RepoInfo>& repos);
+	static bool DecodeRepos(const std::string& response, const RepoCallback& callback);
+	static bool DecodeReleases(const std::string& response, std::vector<ReleaseData>& releases);
+	static bool DecodeReleases(const std::string& response, const uint32_t& repo, AssetTable& assets);
 
 private:
 	// URL building-blocks
 	static const std::string apiRoot;
 
 	// JSON tags
-	static const std::string userURLTag;
-	static const std::string userReposURLTag;
+	static constexpr char userURLTag[] = "user_url";
+	static constexpr char userReposURLTag[] = "repository_url";
 
-	static const std::string reposURLTag;
-	static const std::string nameTag;
-	static const std::string repoCountTag;
-	static const std::string creationTimeTag;
+	static constexpr char reposURLTag[] = "repos_url";
+	static constexpr char nameTag[] = "name";
+	static constexpr char repoCountTag[] = "public_repos";
+	static constexpr char creationTimeTag[] = "created_at";
 
-	static const std::string descriptionTag;
-	static const std::string releasesURLTag;
-	static const std::string updateTimeTag;
-	static const std::string languageTag;
+	static constexpr char descriptionTag[] = "description";
+	static constexpr char releasesURLTag[] = "releases_url";
+	static constexpr char updateTimeTag[] = "updated_at";
+	static constexpr char languageTag[] = "language";
 
-	static const std::string tagNameTag;
-	static const std::string assetTag;
-	static const std::string sizeTag;
-	static const std::string downloadCountTag;
+	static constexpr char tagNameTag[] = "tag_name";
+	static constexpr char assetTag[] = "assets";
+	static constexpr char sizeTag[] = "size";
+	static constexpr char downloadCountTag[] = "download_count";
+
+	template<typename T>
+	friend struct JSONSchema;
 
 	std::string userURL;
 	std::string reposURLRoot;
 
-	RepoInfo GetRepoData(cJSON* repoNode);
-	ReleaseData GetReleaseData(cJSON* releaseNode);
-	AssetData GetAssetData(cJSON* assetNode);
-
 	struct AuthData : public ModificationData
 	{
 		AuthData(struct curl_slist*& headerList, const std::string& token) : headerList(headerList), token(token) {}
@@ -93,9 +119,18 @@ private:
 	const AuthData authData;
 	struct curl_slist* headerList = nullptr;
 
+	ParsePool parsePool;
+
 	static bool AddCurlAuthentication(CURL* curl, const ModificationData* data);
 
-	static std::string AppendPageToURL(const std::string& root, const unsigned int& page);
+	// Reports the number of repos the user has (if known) before the first
+	// callback, so the caller can reserve space
+	bool GetUsersRepos(const RepoCallback& callback, size_t& expectedCount);
+
+	// Builds root?page=<page> into url, reusing its buffer
+	static void BuildPageURL(const std::string& root, const unsigned int& page, std::string& url);
+	static void TrimReleasesURL(RepoInfo& info);
+	static void ClassifyAssets(ReleaseData& release);
 };
 
 #endif// GIT_HUB_INTERFACE_H_
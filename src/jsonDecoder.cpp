@@ -0,0 +1,568 @@
+// File:  jsonDecoder.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Schema-bound JSON decoder.  Structures declare (via a JSONSchema
+//        specialization) which JSON keys map to which members, and the decoder
+//        fills them in a single pass over the raw text without building a DOM.
+
+// Local headers
+#include "jsonDecoder.h"
+
+// Standard C++ headers
+#include <charconv>
+#include <limits>
+
+JSONScanner::JSONScanner(const char* begin, const char* end) : begin(begin), end(end), position(begin)
+{
+}
+
+JSONScanner::JSONScanner(const std::string& text) : JSONScanner(text.data(), text.data() + text.length())
+{
+}
+
+void JSONScanner::SkipWhitespace()
+{
+	while (position < end && static_cast<unsigned char>(*position) <= 32)
+		++position;
+}
+
+bool JSONScanner::Fail()
+{
+	if (!error)
+		error = position;
+	return false;
+}
+
+bool JSONScanner::Expect(const char& c)
+{
+	SkipWhitespace();
+	if (position == end || *position != c)
+		return Fail();
+	++position;
+	return true;
+}
+
+JSONScanner::ValueType JSONScanner::PeekType()
+{
+	SkipWhitespace();
+	if (error || position == end)
+		return ValueType::Invalid;
+
+	switch (*position)
+	{
+	case '{':
+		return ValueType::Object;
+	case '[':
+		return ValueType::Array;
+	case '"':
+		return ValueType::String;
+	case 't':
+		return ValueType::True;
+	case 'f':
+		return ValueType::False;
+	case 'n':
+		return ValueType::Null;
+	default:
+		if (*position == '-' || (*position >= '0' && *position <= '9'))
+			return ValueType::Number;
+	}
+
+	return ValueType::Invalid;
+}
+
+bool JSONScanner::BeginObject()
+{
+	if (!Expect('{'))
+		return false;
+	atContainerStart = true;
+	return true;
+}
+
+bool JSONScanner::NextMember(const char*& key, size_t& keyLength)
+{
+	SkipWhitespace();
+	if (error || position == end)
+		return Fail();
+
+	if (*position == '}')
+	{
+		++position;
+		atContainerStart = false;
+		return false;
+	}
+
+	if (!atContainerStart && !Expect(','))
+		return false;
+	atContainerStart = false;
+
+	// Keys are compared on their raw bytes - GitHub never escapes its keys
+	SkipWhitespace();
+	const char* keyStart(position + 1);
+	if (!SkipString())
+		return false;
+	key = keyStart;
+	keyLength = static_cast<size_t>(position - 1 - keyStart);
+
+	return Expect(':');
+}
+
+bool JSONScanner::BeginArray()
+{
+	if (!Expect('['))
+		return false;
+	atContainerStart = true;
+	return true;
+}
+
+bool JSONScanner::NextElement()
+{
+	SkipWhitespace();
+	if (error || position == end)
+		return Fail();
+
+	if (*position == ']')
+	{
+		++position;
+		atContainerStart = false;
+		return false;
+	}
+
+	if (!atContainerStart && !Expect(','))
+		return false;
+	atContainerStart = false;
+	return true;
+}
+
+bool JSONScanner::SkipString(bool* escaped)
+{
+	if (position == end || *position != '"')
+		return Fail();
+
+	if (escaped)
+		*escaped = false;
+
+	++position;
+	while (position < end)
+	{
+		if (*position == '"')
+		{
+			++position;
+			return true;
+		}
+		else if (*position == '\\')
+		{
+			if (escaped)
+				*escaped = true;
+			++position;
+		}
+		++position;
+	}
+
+	return Fail();
+}
+
+bool JSONScanner::ReadString(std::string& value)
+{
+	SkipWhitespace();
+	const char* start(position + 1);
+	bool escaped;
+	if (!SkipString(&escaped))
+		return false;
+
+	const char* stringEnd(position - 1);
+	if (!escaped)
+	{
+		value.assign(start, stringEnd);
+		return true;
+	}
+
+	if (!UnescapeJSONString(start, stringEnd, value))
+	{
+		position = start;
+		return Fail();
+	}
+
+	return true;
+}
+
+bool JSONScanner::ReadString(InternedString& value)
+{
+	SkipWhitespace();
+	const char* start(position + 1);
+	bool escaped;
+	if (!SkipString(&escaped))
+		return false;
+
+	const char* stringEnd(position - 1);
+	if (!escaped)
+	{
+		value = InternedString(std::string_view(start, stringEnd - start));
+		return true;
+	}
+
+	// Escaped names are rare; unescape through a reused per-thread buffer
+	thread_local std::string unescaped;
+	if (!UnescapeJSONString(start, stringEnd, unescaped))
+	{
+		position = start;
+		return Fail();
+	}
+
+	value = InternedString(unescaped);
+	return true;
+}
+
+bool JSONScanner::ReadString(Timestamp& value)
+{
+	SkipWhitespace();
+	const char* start(position + 1);
+	bool escaped;
+	if (!SkipString(&escaped))
+		return false;
+
+	if (!escaped)
+		Timestamp::Parse(start, position - 1 - start, value);
+	return true;
+}
+
+bool JSONScanner::ScanNumber(const char*& numberEnd)
+{
+	SkipWhitespace();
+	const char* p(position);
+	if (p < end && *p == '-')
+		++p;
+	if (p == end || *p < '0' || *p > '9')
+		return Fail();
+	while (p < end && *p >= '0' && *p <= '9')
+		++p;
+	if (p < end && *p == '.')
+	{
+		++p;
+		while (p < end && *p >= '0' && *p <= '9')
+			++p;
+	}
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		++p;
+		if (p < end && (*p == '+' || *p == '-'))
+			++p;
+		while (p < end && *p >= '0' && *p <= '9')
+			++p;
+	}
+
+	numberEnd = p;
+	return true;
+}
+
+template<typename T>
+static bool ParseNumber(const char* start, const char* end, T& value)
+{
+	T temp;
+	const auto result(std::from_chars(start, end, temp));
+	if (result.ec == std::errc() && result.ptr == end)
+	{
+		value = temp;
+		return true;
+	}
+
+	// Integer field holding a fractional or exponential value - accept via double
+	double d;
+	const auto dResult(std::from_chars(start, end, d));
+	if (dResult.ec != std::errc() || dResult.ptr != end
+		|| d < static_cast<double>(std::numeric_limits<T>::min())
+		|| !(d < static_cast<double>(std::numeric_limits<T>::max()) + 1.0))// max itself may round up for 64-bit types
+		return false;
+	value = static_cast<T>(d);
+	return true;
+}
+
+bool ParseJSONNumber(const char* begin, const char* end, int& value)
+{
+	return ParseNumber(begin, end, value);
+}
+
+bool ParseJSONNumber(const char* begin, const char* end, unsigned int& value)
+{
+	return begin < end && *begin != '-' && ParseNumber(begin, end, value);
+}
+
+bool ParseJSONNumber(const char* begin, const char* end, uint64_t& value)
+{
+	return begin < end && *begin != '-' && ParseNumber(begin, end, value);
+}
+
+bool ParseJSONNumber(const char* begin, const char* end, double& value)
+{
+	const auto result(std::from_chars(begin, end, value));
+	return result.ec == std::errc() && result.ptr == end;
+}
+
+bool JSONScanner::ReadNumber(int& value)
+{
+	const char* numberEnd;
+	if (!ScanNumber(numberEnd))
+		return false;
+	if (!ParseJSONNumber(position, numberEnd, value))
+		return Fail();
+	position = numberEnd;
+	return true;
+}
+
+bool JSONScanner::ReadNumber(unsigned int& value)
+{
+	const char* numberEnd;
+	if (!ScanNumber(numberEnd))
+		return false;
+	if (!ParseJSONNumber(position, numberEnd, value))
+		return Fail();
+	position = numberEnd;
+	return true;
+}
+
+bool JSONScanner::ReadNumber(uint64_t& value)
+{
+	const char* numberEnd;
+	if (!ScanNumber(numberEnd))
+		return false;
+	if (!ParseJSONNumber(position, numberEnd, value))
+		return Fail();
+	position = numberEnd;
+	return true;
+}
+
+bool JSONScanner::ReadNumber(double& value)
+{
+	const char* numberEnd;
+	if (!ScanNumber(numberEnd))
+		return false;
+	if (!ParseJSONNumber(position, numberEnd, value))
+		return Fail();
+	position = numberEnd;
+	return true;
+}
+
+bool ReadJSONValue(const JSONTapeNode& node, InternedString& value)
+{
+	if (!node.Is(JSONTape::Type::String))
+		return true;
+
+	if (!node.IsEscaped())
+	{
+		value = InternedString(std::string_view(node.GetRaw(), node.GetRawLength()));
+		return true;
+	}
+
+	thread_local std::string unescaped;
+	if (!node.GetString(unescaped))
+		return false;
+	value = InternedString(unescaped);
+	return true;
+}
+
+bool JSONScanner::ReadLiteral(const char* literal, const size_t& length)
+{
+	SkipWhitespace();
+	if (static_cast<size_t>(end - position) < length || memcmp(position, literal, length) != 0)
+		return Fail();
+	position += length;
+	return true;
+}
+
+bool JSONScanner::ReadBool(bool& value)
+{
+	SkipWhitespace();
+	if (position < end && *position == 't')
+	{
+		value = true;
+		return ReadLiteral("true", 4);
+	}
+
+	value = false;
+	return ReadLiteral("false", 5);
+}
+
+bool JSONScanner::ReadNull()
+{
+	return ReadLiteral("null", 4);
+}
+
+bool JSONScanner::SkipValue()
+{
+	bool dummy;
+	switch (PeekType())
+	{
+	case ValueType::String:
+		return SkipString();
+
+	case ValueType::Number:
+	{
+		const char* numberEnd;
+		if (!ScanNumber(numberEnd))
+			return false;
+		position = numberEnd;
+		return true;
+	}
+
+	case ValueType::True:
+	case ValueType::False:
+		return ReadBool(dummy);
+
+	case ValueType::Null:
+		return ReadNull();
+
+	case ValueType::Object:
+	case ValueType::Array:
+		break;
+
+	default:
+		return Fail();
+	}
+
+	// Containers are skipped by bracket counting rather than recursion; the
+	// structure is validated only as far as needed to find the matching close
+	size_t depth(0);
+	while (position < end)
+	{
+		switch (*position)
+		{
+		case '"':
+			if (!SkipString())
+				return false;
+			continue;
+
+		case '{':
+		case '[':
+			++depth;
+			break;
+
+		case '}':
+		case ']':
+			if (--depth == 0)
+			{
+				++position;
+				atContainerStart = false;
+				return true;
+			}
+			break;
+
+		default:
+			break;
+		}
+		++position;
+	}
+
+	return Fail();
+}
+
+bool JSONScanner::Finish()
+{
+	SkipWhitespace();
+	if (error)
+		return false;
+	if (position != end)
+		return Fail();
+	return true;
+}
+
+JSONBindingHandler::JSONBindingHandler(void* root, const JSONEventBinding& rootBinding,
+	const bool& rootIsArray) : root(root), rootBinding(rootBinding), rootIsArray(rootIsArray)
+{
+}
+
+bool JSONBindingHandler::Open(const bool& isArray)
+{
+	if (skipDepth > 0)
+	{
+		++skipDepth;
+		return true;
+	}
+
+	if (frames.empty())
+	{
+		// As with DecodeJSON(), the document must be of the expected type
+		if (isArray != rootIsArray)
+			return false;
+		frames.push_back(Frame{ root, &rootBinding, -1 });
+		return true;
+	}
+
+	Frame& top(frames.back());
+	void* child(nullptr);
+	const JSONEventBinding* binding(top.binding->container(top.target, top.member, isArray, child));
+	top.member = -1;
+	if (!binding)
+		skipDepth = 1;
+	else
+		frames.push_back(Frame{ child, binding, -1 });
+
+	return true;
+}
+
+bool JSONBindingHandler::Close()
+{
+	if (skipDepth > 0)
+	{
+		--skipDepth;
+		return true;
+	}
+
+	frames.pop_back();
+	return ContainerClosed(frames.size());
+}
+
+bool JSONBindingHandler::Key(const char* key, const size_t& length)
+{
+	if (skipDepth == 0)
+		frames.back().member = frames.back().binding->findMember(key, length);
+	return true;
+}
+
+bool JSONBindingHandler::String(const char* value, const size_t& length)
+{
+	if (skipDepth > 0)
+		return true;
+	else if (frames.empty())
+		return false;
+
+	Frame& top(frames.back());
+	const bool result(top.binding->string(top.target, top.member, value, length));
+	top.member = -1;
+	return result;
+}
+
+bool JSONBindingHandler::Number(const char* text, const size_t& length)
+{
+	if (skipDepth > 0)
+		return true;
+	else if (frames.empty())
+		return false;
+
+	Frame& top(frames.back());
+	const bool result(top.binding->number(top.target, top.member, text, length));
+	top.member = -1;
+	return result;
+}
+
+bool JSONBindingHandler::Bool(const bool& value)
+{
+	if (skipDepth > 0)
+		return true;
+	else if (frames.empty())
+		return false;
+
+	Frame& top(frames.back());
+	const bool result(top.binding->boolean(top.target, top.member, value));
+	top.member = -1;
+	return result;
+}
+
+bool JSONBindingHandler::Null()
+{
+	if (skipDepth > 0)
+		return true;
+	else if (frames.empty())
+		return false;
+
+	frames.back().member = -1;
+	return true;
+}
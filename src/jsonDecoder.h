@@ -0,0 +1,677 @@
+// File:  jsonDecoder.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Schema-bound JSON decoder.  Structures declare (via a JSONSchema
+//        specialization) which JSON keys map to which members, and the decoder
+//        fills them in a single pass over the raw text without building a DOM.
+
+#ifndef JSON_DECODER_H_
+#define JSON_DECODER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <tuple>
+#include <array>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+// Local headers
+#include "jsonEventParser.h"
+#include "jsonTape.h"
+#include "stringInterner.h"
+#include "timestamp.h"
+
+// Pull-style tokenizer over a block of JSON text.  Nothing is allocated except
+// when a string value is copied out.
+class JSONScanner
+{
+public:
+	JSONScanner(const char* begin, const char* end);
+	explicit JSONScanner(const std::string& text);
+
+	enum class ValueType
+	{
+		Object,
+		Array,
+		String,
+		Number,
+		True,
+		False,
+		Null,
+		Invalid
+	};
+
+	ValueType PeekType();
+
+	// Containers are walked by calling Begin*() followed by Next*() until it
+	// returns false (end of container or error - check HasError()).
+	bool BeginObject();
+	bool NextMember(const char*& key, size_t& keyLength);
+	bool BeginArray();
+	bool NextElement();
+
+	bool ReadString(std::string& value);
+	bool ReadString(InternedString& value);
+	bool ReadString(Timestamp& value);// Unparsable times are skipped
+	bool ReadNumber(int& value);
+	bool ReadNumber(unsigned int& value);
+	bool ReadNumber(uint64_t& value);
+	bool ReadNumber(double& value);
+	bool ReadBool(bool& value);
+	bool ReadNull();
+	bool SkipValue();
+
+	// Returns true if only whitespace remains
+	bool Finish();
+
+	bool HasError() const { return error != nullptr; }
+	size_t GetErrorOffset() const { return error ? static_cast<size_t>(error - begin) : 0; }
+
+private:
+	const char* const begin;
+	const char* const end;
+	const char* position;
+	const char* error = nullptr;
+
+	// Set immediately after entering a container, so the first member/element
+	// isn't required to be preceded by a comma
+	bool atContainerStart = false;
+
+	void SkipWhitespace();
+	bool Fail();
+	bool Expect(const char& c);
+	bool ScanNumber(const char*& numberEnd);
+	bool SkipString(bool* escaped = nullptr);
+	bool ReadLiteral(const char* literal, const size_t& length);
+};
+
+// Convert number text to the specified type; fails on malformed or
+// out-of-range values
+bool ParseJSONNumber(const char* begin, const char* end, int& value);
+bool ParseJSONNumber(const char* begin, const char* end, unsigned int& value);
+bool ParseJSONNumber(const char* begin, const char* end, uint64_t& value);
+bool ParseJSONNumber(const char* begin, const char* end, double& value);
+
+template<typename Owner, typename Member>
+struct JSONField
+{
+	const char* key;
+	Member Owner::*member;
+};
+
+template<typename Owner, typename Member>
+constexpr JSONField<Owner, Member> MakeJSONField(const char* key, Member Owner::*member)
+{
+	return JSONField<Owner, Member>{ key, member };
+}
+
+// Specialize for each decodable type with a single member:
+//   static constexpr auto fields = std::make_tuple(MakeJSONField(...), ...);
+template<typename T>
+struct JSONSchema;
+
+struct JSONKeyEntry
+{
+	uint32_t hash;
+	size_t length;
+};
+
+constexpr size_t JSONKeyLength(const char* key)
+{
+	size_t length(0);
+	while (key[length] != '\0')
+		++length;
+	return length;
+}
+
+// FNV-1a
+constexpr uint32_t HashJSONKey(const char* key, const size_t& length)
+{
+	uint32_t hash(2166136261u);
+	for (size_t i = 0; i < length; ++i)
+		hash = (hash ^ static_cast<unsigned char>(key[i])) * 16777619u;
+	return hash;
+}
+
+template<typename T, size_t... I>
+constexpr std::array<JSONKeyEntry, sizeof...(I)> BuildJSONKeyTable(std::index_sequence<I...>)
+{
+	return {{ JSONKeyEntry{ HashJSONKey(std::get<I>(JSONSchema<T>::fields).key,
+		JSONKeyLength(std::get<I>(JSONSchema<T>::fields).key)),
+		JSONKeyLength(std::get<I>(JSONSchema<T>::fields).key) }... }};
+}
+
+template<typename T>
+struct JSONKeyTable
+{
+	static constexpr size_t size = std::tuple_size<decltype(JSONSchema<T>::fields)>::value;
+	static constexpr std::array<JSONKeyEntry, size> entries = BuildJSONKeyTable<T>(std::make_index_sequence<size>());
+};
+
+// Value readers.  A null (or a value of an unexpected type) leaves the
+// destination untouched; only malformed text is treated as an error.
+inline bool ReadJSONValue(JSONScanner& scanner, std::string& value)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type == JSONScanner::ValueType::String)
+		return scanner.ReadString(value);
+	return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+}
+
+inline bool ReadJSONValue(JSONScanner& scanner, InternedString& value)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type == JSONScanner::ValueType::String)
+		return scanner.ReadString(value);
+	return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+}
+
+inline bool ReadJSONValue(JSONScanner& scanner, Timestamp& value)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type == JSONScanner::ValueType::String)
+		return scanner.ReadString(value);
+	return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+}
+
+template<typename T>
+inline bool ReadJSONNumber(JSONScanner& scanner, T& value)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type == JSONScanner::ValueType::Number)
+		return scanner.ReadNumber(value);
+	return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+}
+
+inline bool ReadJSONValue(JSONScanner& scanner, int& value) { return ReadJSONNumber(scanner, value); }
+inline bool ReadJSONValue(JSONScanner& scanner, unsigned int& value) { return ReadJSONNumber(scanner, value); }
+inline bool ReadJSONValue(JSONScanner& scanner, uint64_t& value) { return ReadJSONNumber(scanner, value); }
+inline bool ReadJSONValue(JSONScanner& scanner, double& value) { return ReadJSONNumber(scanner, value); }
+
+inline bool ReadJSONValue(JSONScanner& scanner, bool& value)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type == JSONScanner::ValueType::True || type == JSONScanner::ValueType::False)
+		return scanner.ReadBool(value);
+	return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+}
+
+template<typename T>
+bool ReadJSONValue(JSONScanner& scanner, std::vector<T>& values);
+
+template<typename T>
+bool ReadJSONValue(JSONScanner& scanner, T& object);
+
+// Tape-based readers - the same rules apply, but unmatched values are never
+// visited at all
+inline bool ReadJSONValue(const JSONTapeNode& node, std::string& value)
+{
+	return !node.Is(JSONTape::Type::String) || node.GetString(value);
+}
+
+// Unescaped strings are interned straight from the source text
+bool ReadJSONValue(const JSONTapeNode& node, InternedString& value);
+
+inline bool ReadJSONValue(const JSONTapeNode& node, Timestamp& value)
+{
+	if (node.Is(JSONTape::Type::String) && !node.IsEscaped())
+		Timestamp::Parse(node.GetRaw(), node.GetRawLength(), value);
+	return true;
+}
+
+inline bool ReadJSONValue(const JSONTapeNode& node, int& value)
+{
+	return !node.Is(JSONTape::Type::Number) || node.GetNumber(value);
+}
+
+inline bool ReadJSONValue(const JSONTapeNode& node, unsigned int& value)
+{
+	return !node.Is(JSONTape::Type::Number) || node.GetNumber(value);
+}
+
+inline bool ReadJSONValue(const JSONTapeNode& node, uint64_t& value)
+{
+	return !node.Is(JSONTape::Type::Number) || node.GetNumber(value);
+}
+
+inline bool ReadJSONValue(const JSONTapeNode& node, double& value)
+{
+	return !node.Is(JSONTape::Type::Number) || node.GetNumber(value);
+}
+
+inline bool ReadJSONValue(const JSONTapeNode& node, bool& value)
+{
+	node.GetBool(value);
+	return true;
+}
+
+template<typename T>
+bool ReadJSONValue(const JSONTapeNode& node, std::vector<T>& values);
+
+template<typename T>
+bool ReadJSONValue(const JSONTapeNode& node, T& object);
+
+inline bool SkipJSONValue(JSONScanner& scanner) { return scanner.SkipValue(); }
+inline bool SkipJSONValue(const JSONTapeNode&) { return true; }
+
+template<typename Source, typename T, typename Owner, typename Member>
+bool DecodeJSONField(Source& source, T& object, const JSONField<Owner, Member>& field)
+{
+	return ReadJSONValue(source, object.*field.member);
+}
+
+template<typename Source, typename T, size_t... I>
+bool DecodeJSONMember(Source& source, T& object, const char* key, const size_t& keyLength,
+	std::index_sequence<I...>)
+{
+	const uint32_t hash(HashJSONKey(key, keyLength));
+	bool result(true);
+	const bool matched(((JSONKeyTable<T>::entries[I].hash == hash
+		&& JSONKeyTable<T>::entries[I].length == keyLength
+		&& memcmp(std::get<I>(JSONSchema<T>::fields).key, key, keyLength) == 0
+		&& ((result = DecodeJSONField(source, object, std::get<I>(JSONSchema<T>::fields))), true)) || ...));
+
+	if (!matched)
+		return SkipJSONValue(source);
+	return result;
+}
+
+template<typename T>
+bool ReadJSONValue(JSONScanner& scanner, T& object)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type != JSONScanner::ValueType::Object)
+		return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+
+	if (!scanner.BeginObject())
+		return false;
+
+	const char* key;
+	size_t keyLength;
+	while (scanner.NextMember(key, keyLength))
+	{
+		if (!DecodeJSONMember(scanner, object, key, keyLength,
+			std::make_index_sequence<JSONKeyTable<T>::size>()))
+			return false;
+	}
+
+	return !scanner.HasError();
+}
+
+template<typename T>
+bool ReadJSONValue(JSONScanner& scanner, std::vector<T>& values)
+{
+	const JSONScanner::ValueType type(scanner.PeekType());
+	if (type != JSONScanner::ValueType::Array)
+		return type != JSONScanner::ValueType::Invalid && scanner.SkipValue();
+
+	if (!scanner.BeginArray())
+		return false;
+
+	while (scanner.NextElement())
+	{
+		values.emplace_back();
+		if (!ReadJSONValue(scanner, values.back()))
+			return false;
+	}
+
+	return !scanner.HasError();
+}
+
+template<typename T>
+bool ReadJSONValue(const JSONTapeNode& node, T& object)
+{
+	if (!node.Is(JSONTape::Type::Object))
+		return true;
+
+	for (JSONTapeNode key(node.GetFirstChild()); key.IsValid(); key = key.GetValue().GetNext())
+	{
+		const JSONTapeNode value(key.GetValue());
+		if (!DecodeJSONMember(value, object, key.GetRaw(), key.GetRawLength(),
+			std::make_index_sequence<JSONKeyTable<T>::size>()))
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+bool ReadJSONValue(const JSONTapeNode& node, std::vector<T>& values)
+{
+	if (!node.Is(JSONTape::Type::Array))
+		return true;
+
+	values.reserve(values.size() + node.GetSize());
+	for (JSONTapeNode element(node.GetFirstChild()); element.IsValid(); element = element.GetNext())
+	{
+		values.emplace_back();
+		if (!ReadJSONValue(element, values.back()))
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+JSONScanner::ValueType JSONDocumentType(const T&) { return JSONScanner::ValueType::Object; }
+
+template<typename T>
+JSONScanner::ValueType JSONDocumentType(const std::vector<T>&) { return JSONScanner::ValueType::Array; }
+
+// Decodes an entire document into value (an object with a JSONSchema or a
+// vector of such objects).  Unlike nested values, a top-level value of the
+// wrong type (e.g. an error message object in place of an array) is a failure.
+template<typename T>
+bool DecodeJSON(const std::string& text, T& value)
+{
+	JSONScanner scanner(text);
+	if (scanner.PeekType() != JSONDocumentType(value))
+		return false;
+	return ReadJSONValue(scanner, value) && scanner.Finish();
+}
+
+template<typename T>
+JSONTape::Type JSONTapeDocumentType(const T&) { return JSONTape::Type::Object; }
+
+template<typename T>
+JSONTape::Type JSONTapeDocumentType(const std::vector<T>&) { return JSONTape::Type::Array; }
+
+// As above, but from an already-parsed tape
+template<typename T>
+bool DecodeJSON(const JSONTape& tape, T& value)
+{
+	const JSONTapeNode root(tape.GetRoot());
+	if (!root.Is(JSONTapeDocumentType(value)))
+		return false;
+	return ReadJSONValue(root, value);
+}
+
+// Returns a decoded value to its default state while keeping any buffers it
+// owns, so a record that is decoded repeatedly stops allocating once its
+// strings have grown to size.  Members outside the schema are left as they are.
+inline void ResetJSONValue(std::string& value) { value.clear(); }
+inline void ResetJSONValue(InternedString& value) { value = InternedString(); }
+inline void ResetJSONValue(Timestamp& value) { value = Timestamp(); }
+inline void ResetJSONValue(int& value) { value = 0; }
+inline void ResetJSONValue(unsigned int& value) { value = 0; }
+inline void ResetJSONValue(uint64_t& value) { value = 0; }
+inline void ResetJSONValue(double& value) { value = 0.0; }
+inline void ResetJSONValue(bool& value) { value = false; }
+
+template<typename T>
+void ResetJSONValue(std::vector<T>& values) { values.clear(); }
+
+template<typename T>
+void ResetJSONValue(T& object)
+{
+	std::apply([&object](const auto&... field) { (ResetJSONValue(object.*field.member), ...); }, JSONSchema<T>::fields);
+}
+
+// Event-driven binding of JSONSchema types.  The same schemas used by
+// DecodeJSON() can be filled from JSONEventParser events, which allows records
+// to be decoded while the text is still arriving.
+struct JSONEventBinding
+{
+	// Returns the member index for the key, or -1 if the key is not in the schema
+	int (*findMember)(const char* key, const size_t& length);
+
+	// Scalar values; member is ignored for arrays
+	bool (*string)(void* target, const int& member, const char* value, const size_t& length);
+	bool (*number)(void* target, const int& member, const char* text, const size_t& length);
+	bool (*boolean)(void* target, const int& member, const bool& value);
+
+	// Returns the binding for a nested container (setting child to its
+	// destination), or nullptr if the container should be skipped
+	const JSONEventBinding* (*container)(void* target, const int& member, const bool& isArray, void*& child);
+};
+
+// Scalar assignment - values of unexpected types are ignored
+template<typename T>
+bool BindJSONString(T&, const char*, const size_t&) { return true; }
+inline bool BindJSONString(std::string& value, const char* s, const size_t& length) { value.assign(s, length); return true; }
+inline bool BindJSONString(InternedString& value, const char* s, const size_t& length) { value = InternedString(std::string_view(s, length)); return true; }
+inline bool BindJSONString(Timestamp& value, const char* s, const size_t& length) { Timestamp::Parse(s, length, value); return true; }
+
+template<typename T>
+bool BindJSONNumber(T&, const char*, const size_t&) { return true; }
+inline bool BindJSONNumber(int& value, const char* s, const size_t& length) { return ParseJSONNumber(s, s + length, value); }
+inline bool BindJSONNumber(unsigned int& value, const char* s, const size_t& length) { return ParseJSONNumber(s, s + length, value); }
+inline bool BindJSONNumber(uint64_t& value, const char* s, const size_t& length) { return ParseJSONNumber(s, s + length, value); }
+inline bool BindJSONNumber(double& value, const char* s, const size_t& length) { return ParseJSONNumber(s, s + length, value); }
+
+template<typename T>
+bool BindJSONBool(T&, const bool&) { return true; }
+inline bool BindJSONBool(bool& value, const bool& b) { value = b; return true; }
+
+template<typename T>
+struct JSONObjectEventBinding;
+
+template<typename T>
+struct JSONArrayEventBinding;
+
+template<typename T>
+struct IsJSONScalar : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_same<T, std::string>::value || std::is_same<T, InternedString>::value || std::is_same<T, Timestamp>::value> {};
+
+template<typename T>
+const JSONEventBinding* BindJSONContainer(T& object, const bool& isArray, void*& child)
+{
+	if (isArray)
+		return nullptr;
+	child = &object;
+	return &JSONObjectEventBinding<T>::binding;
+}
+
+inline const JSONEventBinding* BindJSONContainer(std::string&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(InternedString&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(Timestamp&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(int&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(unsigned int&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(uint64_t&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(double&, const bool&, void*&) { return nullptr; }
+inline const JSONEventBinding* BindJSONContainer(bool&, const bool&, void*&) { return nullptr; }
+
+template<typename T>
+const JSONEventBinding* BindJSONContainer(std::vector<T>& values, const bool& isArray, void*& child)
+{
+	if (!isArray)
+		return nullptr;
+	child = &values;
+	return &JSONArrayEventBinding<T>::binding;
+}
+
+template<typename T>
+struct JSONObjectEventBinding
+{
+	static int FindMember(const char* key, const size_t& length)
+	{
+		return FindMember(key, length, HashJSONKey(key, length), std::make_index_sequence<JSONKeyTable<T>::size>());
+	}
+
+	template<size_t... I>
+	static int FindMember(const char* key, const size_t& length, const uint32_t& hash, std::index_sequence<I...>)
+	{
+		int member(-1);
+		((JSONKeyTable<T>::entries[I].hash == hash
+			&& JSONKeyTable<T>::entries[I].length == length
+			&& memcmp(std::get<I>(JSONSchema<T>::fields).key, key, length) == 0
+			&& ((member = static_cast<int>(I)), true)) || ...);
+		return member;
+	}
+
+	// Invokes f on the member with the specified index
+	template<typename F, size_t... I>
+	static bool Apply(T& object, const int& member, F&& f, std::index_sequence<I...>)
+	{
+		bool result(true);
+		((member == static_cast<int>(I) && ((result = f(object.*std::get<I>(JSONSchema<T>::fields).member)), true)) || ...);
+		return result;
+	}
+
+	template<typename F>
+	static bool Apply(void* target, const int& member, F&& f)
+	{
+		return Apply(*static_cast<T*>(target), member, std::forward<F>(f), std::make_index_sequence<JSONKeyTable<T>::size>());
+	}
+
+	static bool String(void* target, const int& member, const char* value, const size_t& length)
+	{
+		return Apply(target, member, [value, &length](auto& m) { return BindJSONString(m, value, length); });
+	}
+
+	static bool Number(void* target, const int& member, const char* text, const size_t& length)
+	{
+		return Apply(target, member, [text, &length](auto& m) { return BindJSONNumber(m, text, length); });
+	}
+
+	static bool Boolean(void* target, const int& member, const bool& value)
+	{
+		return Apply(target, member, [&value](auto& m) { return BindJSONBool(m, value); });
+	}
+
+	static const JSONEventBinding* Container(void* target, const int& member, const bool& isArray, void*& child)
+	{
+		const JSONEventBinding* binding(nullptr);
+		Apply(target, member, [&binding, &isArray, &child](auto& m)
+		{
+			binding = BindJSONContainer(m, isArray, child);
+			return true;
+		});
+		return binding;
+	}
+
+	static constexpr JSONEventBinding binding = { &FindMember, &String, &Number, &Boolean, &Container };
+};
+
+template<typename T>
+struct JSONArrayEventBinding
+{
+	static std::vector<T>& Values(void* target) { return *static_cast<std::vector<T>*>(target); }
+
+	static bool String(void* target, const int&, const char* value, const size_t& length)
+	{
+		if (!IsJSONScalar<T>::value)
+			return true;
+		Values(target).emplace_back();
+		return BindJSONString(Values(target).back(), value, length);
+	}
+
+	static bool Number(void* target, const int&, const char* text, const size_t& length)
+	{
+		if (!IsJSONScalar<T>::value)
+			return true;
+		Values(target).emplace_back();
+		return BindJSONNumber(Values(target).back(), text, length);
+	}
+
+	static bool Boolean(void* target, const int&, const bool& value)
+	{
+		if (!IsJSONScalar<T>::value)
+			return true;
+		Values(target).emplace_back();
+		return BindJSONBool(Values(target).back(), value);
+	}
+
+	static const JSONEventBinding* Container(void* target, const int&, const bool& isArray, void*& child)
+	{
+		std::vector<T>& values(Values(target));
+		values.emplace_back();
+		const JSONEventBinding* binding(BindJSONContainer(values.back(), isArray, child));
+		if (!binding)
+			values.pop_back();
+		return binding;
+	}
+
+	static constexpr JSONEventBinding binding = { nullptr, &String, &Number, &Boolean, &Container };
+};
+
+// Routes parser events into bound destinations.  Containers with no matching
+// destination are skipped without allocating anything.
+class JSONBindingHandler : public JSONEventHandler
+{
+public:
+	JSONBindingHandler(void* root, const JSONEventBinding& rootBinding, const bool& rootIsArray);
+
+	bool StartObject() override { return Open(false); }
+	bool Key(const char* key, const size_t& length) override;
+	bool EndObject() override { return Close(); }
+	bool StartArray() override { return Open(true); }
+	bool EndArray() override { return Close(); }
+
+	bool String(const char* value, const size_t& length) override;
+	bool Number(const char* text, const size_t& length) override;
+	bool Bool(const bool& value) override;
+	bool Null() override;
+
+protected:
+	// Called after a bound container closes; depth is the number of
+	// containers still open
+	virtual bool ContainerClosed(const size_t& /*depth*/) { return true; }
+
+private:
+	struct Frame
+	{
+		void* target;
+		const JSONEventBinding* binding;
+		int member;
+	};
+
+	void* const root;
+	const JSONEventBinding& rootBinding;
+	const bool rootIsArray;
+
+	std::vector<Frame> frames;
+	size_t skipDepth = 0;
+
+	bool Open(const bool& isArray);
+	bool Close();
+};
+
+// Decodes the elements of a top-level array one at a time, passing each
+// completed record to the callback (which may move from it).  Memory use is
+// independent of the number of records, and the record's buffers are reused
+// unless the callback takes them.
+template<typename T>
+class JSONRecordStream : public JSONBindingHandler
+{
+public:
+	typedef std::function<void(T&)> RecordCallback;
+
+	explicit JSONRecordStream(const RecordCallback& callback)
+		: JSONBindingHandler(this, streamBinding, true), callback(callback) {}
+
+	size_t GetRecordCount() const { return recordCount; }
+
+protected:
+	bool ContainerClosed(const size_t& depth) override
+	{
+		if (depth == 1)
+		{
+			callback(record);
+			++recordCount;
+		}
+		return true;
+	}
+
+private:
+	const RecordCallback callback;
+	T record;
+	size_t recordCount = 0;
+
+	static const JSONEventBinding* StartRecord(void* target, const int&, const bool& isArray, void*& child)
+	{
+		JSONRecordStream<T>& stream(*static_cast<JSONRecordStream<T>*>(target));
+		ResetJSONValue(stream.record);
+		return BindJSONContainer(stream.record, isArray, child);
+	}
+
+	static bool Ignore(void*, const int&, const char*, const size_t&) { return true; }
+	static bool IgnoreBool(void*, const int&, const bool&) { return true; }
+
+	static constexpr JSONEventBinding streamBinding = { nullptr, &Ignore, &Ignore, &IgnoreBool, &StartRecord };
+};
+
+#endif// JSON_DECODER_H_
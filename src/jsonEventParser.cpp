@@ -0,0 +1,425 @@
+// File:  jsonEventParser.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Event-driven (SAX-style) JSON parser.  Input may be supplied in
+//        arbitrary chunks (e.g. as it arrives from cURL), and handlers are
+//        notified as each token is recognized, so no tree is ever built.
+
+// Local headers
+#include "jsonEventParser.h"
+
+// Standard C++ headers
+#include <algorithm>
+
+JSONEventParser::JSONEventParser(JSONEventHandler& handler) : handler(handler)
+{
+	Reset();
+}
+
+void JSONEventParser::Reset()
+{
+	state = State::Value;
+	stringIsKey = false;
+	containers.clear();
+	token.clear();
+	unicodeDigits = 0;
+	unicodeValue = 0;
+	highSurrogate = 0;
+	offset = 0;
+	nodeCount = 0;
+	errorOffset = 0;
+	error = JSONParseError::None;
+	failed = false;
+}
+
+bool JSONEventParser::Fail(const size_t& position, const JSONParseError& reason)
+{
+	if (!failed)
+	{
+		failed = true;
+		errorOffset = position;
+		if (error == JSONParseError::None)
+			error = reason;
+	}
+	return false;
+}
+
+// Records that a handler stopped the parse; the caller reports the position via Fail()
+bool JSONEventParser::Abort()
+{
+	if (error == JSONParseError::None)
+		error = JSONParseError::Aborted;
+	return false;
+}
+
+bool JSONEventParser::Parse(const char* data, const size_t& length)
+{
+	if (failed)
+		return false;
+
+	if (limits.maxSize > 0 && length > limits.maxSize - std::min(offset, limits.maxSize))
+		return Fail(limits.maxSize, JSONParseError::Size);
+
+	size_t i(0);
+	while (i < length)
+	{
+		const char c(data[i]);
+		switch (state)
+		{
+		case State::String:
+		{
+			if (highSurrogate != 0 && c != '\\')
+				return Fail(offset + i);
+
+			// Copy the run of ordinary characters in one go
+			size_t runEnd(i);
+			while (runEnd < length && data[runEnd] != '"' && data[runEnd] != '\\'
+				&& static_cast<unsigned char>(data[runEnd]) >= 0x20)
+				++runEnd;
+			token.append(data + i, runEnd - i);
+			i = runEnd;
+			if (i == length)
+				continue;
+
+			if (data[i] == '"')
+			{
+				if (!CompleteString())
+					return Fail(offset + i);
+			}
+			else if (data[i] == '\\')
+				state = State::StringEscape;
+			else
+				return Fail(offset + i);// Unescaped control character
+
+			++i;
+			continue;
+		}
+
+		case State::StringEscape:
+			if (highSurrogate != 0 && c != 'u')
+				return Fail(offset + i);
+
+			state = State::String;
+			switch (c)
+			{
+			case '"': token.push_back('"'); break;
+			case '\\': token.push_back('\\'); break;
+			case '/': token.push_back('/'); break;
+			case 'b': token.push_back('\b'); break;
+			case 'f': token.push_back('\f'); break;
+			case 'n': token.push_back('\n'); break;
+			case 'r': token.push_back('\r'); break;
+			case 't': token.push_back('\t'); break;
+			case 'u':
+				unicodeDigits = 0;
+				unicodeValue = 0;
+				state = State::StringUnicode;
+				break;
+			default:
+				return Fail(offset + i);
+			}
+			++i;
+			continue;
+
+		case State::StringUnicode:
+			unicodeValue <<= 4;
+			if (c >= '0' && c <= '9')
+				unicodeValue |= c - '0';
+			else if (c >= 'a' && c <= 'f')
+				unicodeValue |= c - 'a' + 10;
+			else if (c >= 'A' && c <= 'F')
+				unicodeValue |= c - 'A' + 10;
+			else
+				return Fail(offset + i);
+
+			if (++unicodeDigits == 4)
+			{
+				state = State::String;
+				if (highSurrogate != 0)
+				{
+					if (unicodeValue < 0xDC00 || unicodeValue > 0xDFFF)
+						return Fail(offset + i);
+					AppendUTF8(token, 0x10000 + (((highSurrogate & 0x3FF) << 10) | (unicodeValue & 0x3FF)));
+					highSurrogate = 0;
+				}
+				else if (unicodeValue >= 0xD800 && unicodeValue <= 0xDBFF)
+					highSurrogate = unicodeValue;
+				else if (unicodeValue >= 0xDC00 && unicodeValue <= 0xDFFF)
+					return Fail(offset + i);
+				else
+					AppendUTF8(token, unicodeValue);
+			}
+			++i;
+			continue;
+
+		case State::Number:
+			if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+			{
+				token.push_back(c);
+				++i;
+				continue;
+			}
+
+			if (!CompleteNumber())
+				return Fail(offset + i);
+			continue;// Re-examine this character in the new state
+
+		case State::Literal:
+			if (c >= 'a' && c <= 'z')
+			{
+				token.push_back(c);
+				if (token.length() > 5)
+					return Fail(offset + i);
+				++i;
+				continue;
+			}
+
+			if (!CompleteLiteral())
+				return Fail(offset + i);
+			continue;
+
+		default:
+			break;
+		}
+
+		// Structural states - whitespace between tokens is insignificant
+		if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+		{
+			++i;
+			continue;
+		}
+
+		switch (state)
+		{
+		case State::Value:
+			if (!ProcessValueStart(c, offset + i))
+				return false;
+			break;
+
+		case State::ValueOrArrayEnd:
+			if (c == ']')
+			{
+				if (!CloseContainer(false))
+					return Fail(offset + i);
+			}
+			else if (!ProcessValueStart(c, offset + i))
+				return false;
+			break;
+
+		case State::KeyOrObjectEnd:
+			if (c == '}')
+			{
+				if (!CloseContainer(true))
+					return Fail(offset + i);
+				break;
+			}
+			// Fall through
+
+		case State::Key:
+			if (c != '"')
+				return Fail(offset + i);
+			if (limits.maxNodes > 0 && ++nodeCount > limits.maxNodes)
+				return Fail(offset + i, JSONParseError::Nodes);
+			token.clear();
+			stringIsKey = true;
+			state = State::String;
+			break;
+
+		case State::Colon:
+			if (c != ':')
+				return Fail(offset + i);
+			state = State::Value;
+			break;
+
+		case State::CommaOrEnd:
+			if (c == ',')
+				state = containers.back() ? State::Key : State::Value;
+			else if ((c == '}' && containers.back()) || (c == ']' && !containers.back()))
+			{
+				if (!CloseContainer(containers.back()))
+					return Fail(offset + i);
+			}
+			else
+				return Fail(offset + i);
+			break;
+
+		default:// Trailing garbage after the document
+			return Fail(offset + i);
+		}
+		++i;
+	}
+
+	offset += length;
+	return true;
+}
+
+bool JSONEventParser::ProcessValueStart(const char& c, const size_t& position)
+{
+	if (limits.maxNodes > 0 && ++nodeCount > limits.maxNodes)
+		return Fail(position, JSONParseError::Nodes);
+
+	switch (c)
+	{
+	case '{':
+	case '[':
+		if (limits.maxDepth > 0 && containers.size() >= limits.maxDepth)
+			return Fail(position, JSONParseError::Depth);
+		containers.push_back(c == '{');
+		state = c == '{' ? State::KeyOrObjectEnd : State::ValueOrArrayEnd;
+		if (!(c == '{' ? handler.StartObject() : handler.StartArray()))
+			return Fail(position, JSONParseError::Aborted);
+		return true;
+
+	case '"':
+		token.clear();
+		stringIsKey = false;
+		state = State::String;
+		return true;
+
+	case 't':
+	case 'f':
+	case 'n':
+		token.assign(1, c);
+		state = State::Literal;
+		return true;
+
+	default:
+		if (c == '-' || (c >= '0' && c <= '9'))
+		{
+			token.assign(1, c);
+			state = State::Number;
+			return true;
+		}
+	}
+
+	return Fail(position);
+}
+
+bool JSONEventParser::CompleteValue()
+{
+	state = containers.empty() ? State::Done : State::CommaOrEnd;
+	return true;
+}
+
+bool JSONEventParser::CompleteString()
+{
+	if (stringIsKey)
+	{
+		state = State::Colon;
+		return handler.Key(token.data(), token.length()) || Abort();
+	}
+
+	if (!handler.String(token.data(), token.length()))
+		return Abort();
+	return CompleteValue();
+}
+
+bool JSONEventParser::CompleteNumber()
+{
+	// Validate against the JSON number grammar:  -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+	size_t i(0);
+	if (token[i] == '-')
+		++i;
+	if (i == token.length() || token[i] < '0' || token[i] > '9')
+		return false;
+	if (token[i++] != '0')
+	{
+		while (i < token.length() && token[i] >= '0' && token[i] <= '9')
+			++i;
+	}
+	if (i < token.length() && token[i] == '.')
+	{
+		const size_t fractionStart(++i);
+		while (i < token.length() && token[i] >= '0' && token[i] <= '9')
+			++i;
+		if (i == fractionStart)
+			return false;
+	}
+	if (i < token.length() && (token[i] == 'e' || token[i] == 'E'))
+	{
+		if (++i < token.length() && (token[i] == '+' || token[i] == '-'))
+			++i;
+		const size_t exponentStart(i);
+		while (i < token.length() && token[i] >= '0' && token[i] <= '9')
+			++i;
+		if (i == exponentStart)
+			return false;
+	}
+	if (i != token.length())
+		return false;
+
+	if (!handler.Number(token.data(), token.length()))
+		return Abort();
+	return CompleteValue();
+}
+
+bool JSONEventParser::CompleteLiteral()
+{
+	bool accepted;
+	if (token.compare("true") == 0)
+		accepted = handler.Bool(true);
+	else if (token.compare("false") == 0)
+		accepted = handler.Bool(false);
+	else if (token.compare("null") == 0)
+		accepted = handler.Null();
+	else
+		return false;
+
+	if (!accepted)
+		return Abort();
+	return CompleteValue();
+}
+
+bool JSONEventParser::CloseContainer(const bool& isObject)
+{
+	containers.pop_back();
+	if (isObject ? !handler.EndObject() : !handler.EndArray())
+		return Abort();
+	return CompleteValue();
+}
+
+bool JSONEventParser::Finish()
+{
+	if (failed)
+		return false;
+
+	if (state == State::Number && !CompleteNumber())
+		return Fail(offset);
+	else if (state == State::Literal && !CompleteLiteral())
+		return Fail(offset);
+
+	if (state != State::Done)
+		return Fail(offset);
+
+	return true;
+}
+
+bool ParseJSONEvents(const std::string& text, JSONEventHandler& handler)
+{
+	JSONEventParser parser(handler);
+	return parser.Parse(text) && parser.Finish();
+}
+
+void AppendUTF8(std::string& s, const unsigned int& codePoint)
+{
+	if (codePoint < 0x80)
+		s.push_back(static_cast<char>(codePoint));
+	else if (codePoint < 0x800)
+	{
+		s.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+		s.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else if (codePoint < 0x10000)
+	{
+		s.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+		s.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		s.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+	else
+	{
+		s.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+		s.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+		s.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+		s.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+	}
+}
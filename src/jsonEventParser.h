@@ -0,0 +1,114 @@
+// File:  jsonEventParser.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Event-driven (SAX-style) JSON parser.  Input may be supplied in
+//        arbitrary chunks (e.g. as it arrives from cURL), and handlers are
+//        notified as each token is recognized, so no tree is ever built.
+
+#ifndef JSON_EVENT_PARSER_H_
+#define JSON_EVENT_PARSER_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "jsonParseLimits.h"
+
+// Receives parse events.  Returning false from any method aborts the parse.
+// String and key pointers are only valid for the duration of the call.
+class JSONEventHandler
+{
+public:
+	virtual ~JSONEventHandler() = default;
+
+	virtual bool StartObject() { return true; }
+	virtual bool Key(const char* /*key*/, const size_t& /*length*/) { return true; }
+	virtual bool EndObject() { return true; }
+	virtual bool StartArray() { return true; }
+	virtual bool EndArray() { return true; }
+
+	virtual bool String(const char* /*value*/, const size_t& /*length*/) { return true; }
+	// Numbers are reported as their source text so no precision is lost
+	virtual bool Number(const char* /*text*/, const size_t& /*length*/) { return true; }
+	virtual bool Bool(const bool& /*value*/) { return true; }
+	virtual bool Null() { return true; }
+};
+
+class JSONEventParser
+{
+public:
+	explicit JSONEventParser(JSONEventHandler& handler);
+
+	// May be called any number of times with successive pieces of the document
+	bool Parse(const char* data, const size_t& length);
+	bool Parse(const std::string& data) { return Parse(data.data(), data.length()); }
+
+	// Call after the last chunk; returns true if a complete document was parsed
+	bool Finish();
+
+	void Reset();
+
+	// Limits persist across calls to Reset()
+	void SetLimits(const JSONParseLimits& newLimits) { limits = newLimits; }
+
+	bool HasError() const { return failed; }
+	JSONParseError GetError() const { return error; }
+	size_t GetErrorOffset() const { return errorOffset; }
+
+private:
+	JSONEventHandler& handler;
+	JSONParseLimits limits;
+
+	enum class State
+	{
+		Value,// Expecting any value
+		ValueOrArrayEnd,// Immediately after '['
+		KeyOrObjectEnd,// Immediately after '{'
+		Key,// After ',' in an object
+		Colon,
+		CommaOrEnd,
+		String,
+		StringEscape,
+		StringUnicode,
+		Number,
+		Literal,
+		Done
+	};
+
+	State state;
+	bool stringIsKey;
+
+	// Open containers; true for objects, false for arrays
+	std::vector<bool> containers;
+
+	// Holds the token currently being assembled (string contents, number or
+	// literal text), reused between tokens
+	std::string token;
+	unsigned int unicodeDigits;
+	unsigned int unicodeValue;
+	unsigned int highSurrogate;
+
+	size_t offset;
+	size_t nodeCount;
+	size_t errorOffset;
+	JSONParseError error;
+	bool failed;
+
+	bool Fail(const size_t& position, const JSONParseError& reason = JSONParseError::Syntax);
+	bool Abort();
+	bool ProcessValueStart(const char& c, const size_t& position);
+	bool CompleteValue();
+	bool CompleteString();
+	bool CompleteNumber();
+	bool CompleteLiteral();
+	bool CloseContainer(const bool& isObject);
+};
+
+// Parses a complete document held in memory
+bool ParseJSONEvents(const std::string& text, JSONEventHandler& handler);
+
+// Appends the UTF-8 encoding of the specified code point
+void AppendUTF8(std::string& s, const unsigned int& codePoint);
+
+#endif// JSON_EVENT_PARSER_H_
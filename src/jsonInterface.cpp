@@ -24,6 +24,8 @@
 
 // Local headers
 #include "jsonInterface.h"
+#include "jsonEventParser.h"
+#include "jsonTape.h"
 #include "cJSON.h"
 
 //==========================================================================
@@ -144,6 +146,68 @@ bool JSONInterface::DoCURLPost(const std::string &url, const std::string &data,
 bool JSONInterface::DoCURLGet(const std::string &url, std::string &response,
 	CURLModification curlModification,
 	const ModificationData* modificationData) const
+{
+	response.clear();
+	return PerformCURLGet(url, JSONInterface::CURLWriteCallback, &response,
+		curlModification, modificationData);
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		DoCURLGet
+//
+// Description:		Creates a cURL object, GETs, and feeds the response to the
+//					specified parser as it is received, then cleans up.
+//
+// Input Arguments:
+//		url		= const std::string&
+//		curlModification	= CURLModification
+//		modificationData	= const ModificationData*
+//
+// Output Arguments:
+//		parser	= JSONEventParser&
+//
+// Return Value:
+//		bool, true for success (including successful parsing of a complete
+//		document), false otherwise
+//
+//==========================================================================
+bool JSONInterface::DoCURLGet(const std::string &url, JSONEventParser &parser,
+	CURLModification curlModification,
+	const ModificationData* modificationData) const
+{
+	parser.Reset();
+	if (!PerformCURLGet(url, JSONInterface::CURLStreamCallback, &parser,
+		curlModification, modificationData))
+		return false;
+
+	return parser.Finish();
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		PerformCURLGet
+//
+// Description:		Creates a cURL object, GETs, passes the response to the
+//					specified write function, and cleans up.
+//
+// Input Arguments:
+//		url				= const std::string&
+//		writeFunction	= CURLWriteFunction
+//		writeData		= void*
+//		curlModification	= CURLModification
+//		modificationData	= const ModificationData*
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::PerformCURLGet(const std::string &url, CURLWriteFunction writeFunction,
+	void* writeData, CURLModification curlModification,
+	const ModificationData* modificationData) const
 {
 	CURL *curl = curl_easy_init();
 	if (!curl)
@@ -152,9 +216,8 @@ bool JSONInterface::DoCURLGet(const std::string &url, std::string &response,
 		return false;
 	}
 
-	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, JSONInterface::CURLWriteCallback);
-	response.clear();
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeFunction);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, writeData);
 
 	if (!caCertificatePath.empty())
 		curl_easy_setopt(curl, CURLOPT_CAPATH, caCertificatePath.c_str());
@@ -216,6 +279,35 @@ size_t JSONInterface::CURLWriteCallback(char *ptr, size_t size, size_t nmemb, vo
 	return totalSize;
 }
 
+//==========================================================================
+// Class:			JSONInterface
+// Function:		CURLStreamCallback
+//
+// Description:		Static member function for receiving returned data from cURL
+//					and passing it directly to a parser.
+//
+// Input Arguments:
+//		ptr			= char*
+//		size		= size_t indicating number of elements of size nmemb
+//		nmemb		= size_t indicating size of each element
+//		userData	= void* (must be pointer to JSONEventParser)
+//
+// Output Arguments:
+//		None
+//
+// Return Value:
+//		size_t indicating number of bytes read (zero aborts the transfer)
+//
+//==========================================================================
+size_t JSONInterface::CURLStreamCallback(char *ptr, size_t size, size_t nmemb, void *userData)
+{
+	size_t totalSize = size * nmemb;
+	if (!static_cast<JSONEventParser*>(userData)->Parse(ptr, totalSize))
+		return 0;
+
+	return totalSize;
+}
+
 //==========================================================================
 // Class:			JSONInterface
 // Function:		ReadJSON
@@ -273,7 +365,43 @@ bool JSONInterface::ReadJSON(cJSON *root, const std::string& field, unsigned int
 		return false;
 	}
 
-	value = static_cast<unsigned int>(element->valueint);
+	if (element->valuedouble < 0.0 || element->valuedouble > 4294967295.0)
+		return false;
+	value = static_cast<unsigned int>(element->valuedouble);
+
+	return true;
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from the JSON array.
+//
+// Input Arguments:
+//		root	= cJSON*
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= uint64_t&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(cJSON *root, const std::string& field, uint64_t &value)
+{
+	cJSON *element = cJSON_GetObjectItem(root, field.c_str());
+	if (!element)
+	{
+		//std::cerr << "Failed to read field '" << field << "' from JSON array" << std::endl;
+		return false;
+	}
+
+	// valueint saturates at INT_MAX; valuedouble is exact up to 2^53
+	if (element->valuedouble < 0.0 || !(element->valuedouble < 18446744073709551616.0))
+		return false;
+	value = static_cast<uint64_t>(element->valuedouble);
 
 	return true;
 }
@@ -340,3 +468,138 @@ bool JSONInterface::ReadJSON(cJSON *root, const std::string& field, double &valu
 
 	return true;
 }
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from a parsed tape.  The value is
+//					only converted when requested.
+//
+// Input Arguments:
+//		root	= const JSONTapeNode&
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= int&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(const JSONTapeNode& root, const std::string& field, int &value)
+{
+	const JSONTapeNode element(root.GetMember(field));
+	if (!element.IsValid())
+		return false;
+
+	return element.GetNumber(value);
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from a parsed tape.  The value is
+//					only converted when requested.
+//
+// Input Arguments:
+//		root	= const JSONTapeNode&
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= unsigned int&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(const JSONTapeNode& root, const std::string& field, unsigned int &value)
+{
+	const JSONTapeNode element(root.GetMember(field));
+	if (!element.IsValid())
+		return false;
+
+	return element.GetNumber(value);
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from a parsed tape.  The value is
+//					only converted when requested.
+//
+// Input Arguments:
+//		root	= const JSONTapeNode&
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= uint64_t&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(const JSONTapeNode& root, const std::string& field, uint64_t &value)
+{
+	const JSONTapeNode element(root.GetMember(field));
+	if (!element.IsValid())
+		return false;
+
+	return element.GetNumber(value);
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from a parsed tape.  The value is
+//					only converted when requested.
+//
+// Input Arguments:
+//		root	= const JSONTapeNode&
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= std::string&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(const JSONTapeNode& root, const std::string& field, std::string &value)
+{
+	const JSONTapeNode element(root.GetMember(field));
+	if (!element.IsValid())
+		return false;
+
+	return element.GetString(value);
+}
+
+//==========================================================================
+// Class:			JSONInterface
+// Function:		ReadJSON
+//
+// Description:		Reads the specified field from a parsed tape.  The value is
+//					only converted when requested.
+//
+// Input Arguments:
+//		root	= const JSONTapeNode&
+//		field	= const std::string&
+//
+// Output Arguments:
+//		value	= double&
+//
+// Return Value:
+//		bool, true for success, false otherwise
+//
+//==========================================================================
+bool JSONInterface::ReadJSON(const JSONTapeNode& root, const std::string& field, double &value)
+{
+	const JSONTapeNode element(root.GetMember(field));
+	if (!element.IsValid())
+		return false;
+
+	return element.GetNumber(value);
+}
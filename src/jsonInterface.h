@@ -8,10 +8,15 @@
 
 // Standard C++ headers
 #include <string>
+#include <cstdint>
 
 // cJSON forward declarations
 struct cJSON;
 
+// Local forward declarations
+class JSONEventParser;
+class JSONTapeNode;
+
 // for cURL
 typedef void CURL;
 
@@ -45,13 +50,29 @@ protected:
 	bool DoCURLGet(const std::string &url, std::string &response,
 		CURLModification curlModification = &JSONInterface::DoNothing,
 		const ModificationData* modificationData = nullptr) const;
+	bool DoCURLGet(const std::string &url, JSONEventParser &parser,
+		CURLModification curlModification = &JSONInterface::DoNothing,
+		const ModificationData* modificationData = nullptr) const;
 
 	static bool ReadJSON(cJSON *root, const std::string& field, int &value);
 	static bool ReadJSON(cJSON *root, const std::string& field, unsigned int &value);
+	static bool ReadJSON(cJSON *root, const std::string& field, uint64_t &value);
 	static bool ReadJSON(cJSON *root, const std::string& field, std::string &value);
 	static bool ReadJSON(cJSON *root, const std::string& field, double &value);
 
+	static bool ReadJSON(const JSONTapeNode& root, const std::string& field, int &value);
+	static bool ReadJSON(const JSONTapeNode& root, const std::string& field, unsigned int &value);
+	static bool ReadJSON(const JSONTapeNode& root, const std::string& field, uint64_t &value);
+	static bool ReadJSON(const JSONTapeNode& root, const std::string& field, std::string &value);
+	static bool ReadJSON(const JSONTapeNode& root, const std::string& field, double &value);
+
 	static size_t CURLWriteCallback(char *ptr, size_t size, size_t nmemb, void *userData);
+	static size_t CURLStreamCallback(char *ptr, size_t size, size_t nmemb, void *userData);
+
+private:
+	typedef size_t (*CURLWriteFunction)(char*, size_t, size_t, void*);
+	bool PerformCURLGet(const std::string &url, CURLWriteFunction writeFunction, void* writeData,
+		CURLModification curlModification, const ModificationData* modificationData) const;
 };
 
 #endif// JSON_INTERFACE_H_
\ No newline at end of file
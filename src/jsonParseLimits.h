@@ -0,0 +1,45 @@
+// File:  jsonParseLimits.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Resource limits shared by the JSON parsers, so a hostile or corrupted
+//        response fails with a clear error instead of exhausting memory.
+
+#ifndef JSON_PARSE_LIMITS_H_
+#define JSON_PARSE_LIMITS_H_
+
+// Standard C++ headers
+#include <cstddef>
+
+// Zero disables the corresponding limit
+struct JSONParseLimits
+{
+	size_t maxDepth = 512;// Nesting of arrays and objects
+	size_t maxSize = 64 * 1024 * 1024;// Bytes
+	size_t maxNodes = 4000000;// Values, including keys and containers
+};
+
+enum class JSONParseError
+{
+	None,
+	Syntax,
+	Depth,
+	Size,
+	Nodes,
+	Aborted// A handler requested that parsing stop
+};
+
+inline const char* GetJSONParseErrorString(const JSONParseError& error)
+{
+	switch (error)
+	{
+	case JSONParseError::None: return "no error";
+	case JSONParseError::Syntax: return "syntax error";
+	case JSONParseError::Depth: return "maximum nesting depth exceeded";
+	case JSONParseError::Size: return "maximum document size exceeded";
+	case JSONParseError::Nodes: return "maximum node count exceeded";
+	case JSONParseError::Aborted: return "aborted by handler";
+	}
+	return "unknown error";
+}
+
+#endif// JSON_PARSE_LIMITS_H_
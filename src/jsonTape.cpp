@@ -0,0 +1,455 @@
+// File:  jsonTape.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Two-stage JSON parser.  The first stage locates every structural
+//        character and records a compact tape of value positions, with jump
+//        offsets past each container.  Values are only converted (unescaped,
+//        number-parsed) when they are requested, so unused subtrees cost O(1).
+
+// Local headers
+#include "jsonTape.h"
+#include "jsonDecoder.h"
+#include "jsonEventParser.h"
+
+// Standard C++ headers
+#include <cstring>
+#include <limits>
+
+bool JSONTape::Fail(const char* position, const JSONParseError& reason)
+{
+	valid = false;
+	error = reason;
+	errorOffset = static_cast<size_t>(position - text);
+	return false;
+}
+
+bool JSONTape::ScanString(const char*& position, const char* end, Entry& entry)
+{
+	const char* start(position + 1);
+	const char* search(start);
+	while (true)
+	{
+		const char* quote(static_cast<const char*>(memchr(search, '"', end - search)));
+		if (!quote)
+			return Fail(position);
+
+		// The quote terminates the string unless preceded by an odd number of backslashes
+		const char* backslash(quote);
+		while (backslash > start && backslash[-1] == '\\')
+			--backslash;
+
+		if ((quote - backslash) % 2 == 0)
+		{
+			entry.type = Type::String;
+			entry.offset = static_cast<uint32_t>(start - text);
+			entry.extent = static_cast<uint32_t>(quote - start);
+			entry.count = 0;
+			entry.escaped = memchr(start, '\\', quote - start) != nullptr;
+			position = quote + 1;
+			return true;
+		}
+
+		search = quote + 1;
+	}
+}
+
+bool JSONTape::Parse(const char* textIn, const size_t& length)
+{
+	text = textIn;
+	valid = false;
+	error = JSONParseError::None;
+	errorOffset = 0;
+	entries.clear();
+	openContainers.clear();
+
+	// Refuse oversized documents before indexing anything
+	if (limits.maxSize > 0 && length > limits.maxSize)
+		return Fail(text + limits.maxSize, JSONParseError::Size);
+	if (length >= std::numeric_limits<uint32_t>::max())
+		return Fail(text, JSONParseError::Size);
+
+	enum class Expect
+	{
+		Value,
+		ValueOrArrayEnd,
+		KeyOrObjectEnd,
+		Key,
+		Colon,
+		CommaOrEnd,
+		Done
+	};
+
+	Expect expect(Expect::Value);
+	const char* p(text);
+	const char* const end(text + length);
+
+	auto closeContainer([this, &expect]()
+	{
+		entries[openContainers.back()].extent = static_cast<uint32_t>(entries.size());
+		openContainers.pop_back();
+		expect = openContainers.empty() ? Expect::Done : Expect::CommaOrEnd;
+	});
+
+	while (true)
+	{
+		while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+			++p;
+		if (p == end)
+			break;
+
+		const char c(*p);
+		switch (expect)
+		{
+		case Expect::Colon:
+			if (c != ':')
+				return Fail(p);
+			++p;
+			expect = Expect::Value;
+			continue;
+
+		case Expect::CommaOrEnd:
+		{
+			const bool inObject(entries[openContainers.back()].type == Type::Object);
+			if (c == ',')
+			{
+				++p;
+				expect = inObject ? Expect::Key : Expect::Value;
+			}
+			else if ((inObject && c == '}') || (!inObject && c == ']'))
+			{
+				++p;
+				closeContainer();
+			}
+			else
+				return Fail(p);
+			continue;
+		}
+
+		case Expect::KeyOrObjectEnd:
+			if (c == '}')
+			{
+				++p;
+				closeContainer();
+				continue;
+			}
+			// Fall through
+
+		case Expect::Key:
+		{
+			if (c != '"')
+				return Fail(p);
+			if (limits.maxNodes > 0 && entries.size() >= limits.maxNodes)
+				return Fail(p, JSONParseError::Nodes);
+			Entry entry;
+			if (!ScanString(p, end, entry))
+				return false;
+			entries.push_back(entry);
+			++entries[openContainers.back()].count;
+			expect = Expect::Colon;
+			continue;
+		}
+
+		case Expect::ValueOrArrayEnd:
+			if (c == ']')
+			{
+				++p;
+				closeContainer();
+				continue;
+			}
+			// Fall through
+
+		case Expect::Value:
+			break;
+
+		default:// Trailing garbage
+			return Fail(p);
+		}
+
+		// Start of a value
+		if (limits.maxNodes > 0 && entries.size() >= limits.maxNodes)
+			return Fail(p, JSONParseError::Nodes);
+		if (!openContainers.empty() && entries[openContainers.back()].type == Type::Array)
+			++entries[openContainers.back()].count;
+
+		Entry entry;
+		entry.offset = static_cast<uint32_t>(p - text);
+		entry.extent = 0;
+		entry.count = 0;
+		entry.escaped = false;
+
+		switch (c)
+		{
+		case '{':
+		case '[':
+			if (limits.maxDepth > 0 && openContainers.size() >= limits.maxDepth)
+				return Fail(p, JSONParseError::Depth);
+			entry.type = c == '{' ? Type::Object : Type::Array;
+			openContainers.push_back(static_cast<uint32_t>(entries.size()));
+			entries.push_back(entry);
+			++p;
+			expect = c == '{' ? Expect::KeyOrObjectEnd : Expect::ValueOrArrayEnd;
+			continue;
+
+		case '"':
+			if (!ScanString(p, end, entry))
+				return false;
+			break;
+
+		case 't':
+		case 'f':
+		case 'n':
+		{
+			const char* literal(c == 't' ? "true" : (c == 'f' ? "false" : "null"));
+			const size_t literalLength(strlen(literal));
+			if (static_cast<size_t>(end - p) < literalLength || memcmp(p, literal, literalLength) != 0)
+				return Fail(p);
+			entry.type = c == 't' ? Type::True : (c == 'f' ? Type::False : Type::Null);
+			entry.extent = static_cast<uint32_t>(literalLength);
+			p += literalLength;
+			break;
+		}
+
+		default:
+		{
+			// Numbers are only delimited here; they're validated when materialized
+			if (c != '-' && (c < '0' || c > '9'))
+				return Fail(p);
+			const char* numberStart(p);
+			while (p < end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+'
+				|| *p == '.' || *p == 'e' || *p == 'E'))
+				++p;
+			entry.type = Type::Number;
+			entry.extent = static_cast<uint32_t>(p - numberStart);
+			break;
+		}
+		}
+
+		entries.push_back(entry);
+		expect = openContainers.empty() ? Expect::Done : Expect::CommaOrEnd;
+	}
+
+	if (expect != Expect::Done)
+		return Fail(p);
+
+	valid = true;
+	return true;
+}
+
+JSONTapeNode JSONTape::GetRoot() const
+{
+	if (!valid || entries.empty())
+		return JSONTapeNode();
+	return JSONTapeNode(this, 0, static_cast<uint32_t>(entries.size()));
+}
+
+JSONTape::Type JSONTapeNode::GetType() const
+{
+	return GetEntry().type;
+}
+
+size_t JSONTapeNode::GetSize() const
+{
+	if (!Is(JSONTape::Type::Object) && !Is(JSONTape::Type::Array))
+		return 0;
+	return GetEntry().count;
+}
+
+uint32_t JSONTapeNode::GetFollowingIndex() const
+{
+	const JSONTape::Entry& entry(GetEntry());
+	if (entry.type == JSONTape::Type::Object || entry.type == JSONTape::Type::Array)
+		return entry.extent;
+	return index + 1;
+}
+
+JSONTapeNode JSONTapeNode::GetFirstChild() const
+{
+	if (GetSize() == 0)
+		return JSONTapeNode();
+	return JSONTapeNode(tape, index + 1, GetEntry().extent);
+}
+
+JSONTapeNode JSONTapeNode::GetNext() const
+{
+	if (!IsValid())
+		return JSONTapeNode();
+
+	const uint32_t next(GetFollowingIndex());
+	if (next >= end)
+		return JSONTapeNode();
+	return JSONTapeNode(tape, next, end);
+}
+
+JSONTapeNode JSONTapeNode::GetValue() const
+{
+	if (!IsValid() || index + 1 >= end)
+		return JSONTapeNode();
+	return JSONTapeNode(tape, index + 1, end);
+}
+
+JSONTapeNode JSONTapeNode::GetMember(const char* key, const size_t& length) const
+{
+	if (!Is(JSONTape::Type::Object))
+		return JSONTapeNode();
+
+	// Keys are compared on their raw bytes - GitHub never escapes its keys
+	for (JSONTapeNode k(GetFirstChild()); k.IsValid(); k = k.GetValue().GetNext())
+	{
+		if (k.GetRawLength() == length && memcmp(k.GetRaw(), key, length) == 0)
+			return k.GetValue();
+	}
+
+	return JSONTapeNode();
+}
+
+JSONTapeNode JSONTapeNode::GetElement(size_t i) const
+{
+	if (!Is(JSONTape::Type::Array) || i >= GetSize())
+		return JSONTapeNode();
+
+	JSONTapeNode element(GetFirstChild());
+	while (i-- > 0)
+		element = element.GetNext();
+	return element;
+}
+
+const char* JSONTapeNode::GetRaw() const
+{
+	if (!IsValid())
+		return nullptr;
+	return tape->text + GetEntry().offset;
+}
+
+size_t JSONTapeNode::GetRawLength() const
+{
+	if (!IsValid() || Is(JSONTape::Type::Object) || Is(JSONTape::Type::Array))
+		return 0;
+	return GetEntry().extent;
+}
+
+bool JSONTapeNode::IsEscaped() const
+{
+	return Is(JSONTape::Type::String) && GetEntry().escaped;
+}
+
+bool JSONTapeNode::GetString(std::string& value) const
+{
+	if (!Is(JSONTape::Type::String))
+		return false;
+
+	const char* raw(GetRaw());
+	if (!GetEntry().escaped)
+	{
+		value.assign(raw, GetEntry().extent);
+		return true;
+	}
+
+	return UnescapeJSONString(raw, raw + GetEntry().extent, value);
+}
+
+bool JSONTapeNode::GetNumber(int& value) const
+{
+	return Is(JSONTape::Type::Number) && ParseJSONNumber(GetRaw(), GetRaw() + GetRawLength(), value);
+}
+
+bool JSONTapeNode::GetNumber(unsigned int& value) const
+{
+	return Is(JSONTape::Type::Number) && ParseJSONNumber(GetRaw(), GetRaw() + GetRawLength(), value);
+}
+
+bool JSONTapeNode::GetNumber(uint64_t& value) const
+{
+	return Is(JSONTape::Type::Number) && ParseJSONNumber(GetRaw(), GetRaw() + GetRawLength(), value);
+}
+
+bool JSONTapeNode::GetNumber(double& value) const
+{
+	return Is(JSONTape::Type::Number) && ParseJSONNumber(GetRaw(), GetRaw() + GetRawLength(), value);
+}
+
+bool JSONTapeNode::GetBool(bool& value) const
+{
+	if (Is(JSONTape::Type::True))
+		value = true;
+	else if (Is(JSONTape::Type::False))
+		value = false;
+	else
+		return false;
+	return true;
+}
+
+static unsigned int ParseHex4(const char* s)
+{
+	unsigned int value(0);
+	for (int i = 0; i < 4; ++i)
+	{
+		value <<= 4;
+		if (s[i] >= '0' && s[i] <= '9')
+			value |= s[i] - '0';
+		else if (s[i] >= 'a' && s[i] <= 'f')
+			value |= s[i] - 'a' + 10;
+		else if (s[i] >= 'A' && s[i] <= 'F')
+			value |= s[i] - 'A' + 10;
+		else
+			return 0x110000;// Invalid marker (outside of unicode range)
+	}
+	return value;
+}
+
+bool UnescapeJSONString(const char* begin, const char* end, std::string& value)
+{
+	value.clear();
+	value.reserve(end - begin);
+
+	const char* p(begin);
+	while (p < end)
+	{
+		const char* run(p);
+		while (p < end && *p != '\\')
+			++p;
+		value.append(run, p);
+		if (p == end)
+			break;
+
+		if (++p == end)
+			return false;
+
+		switch (*p++)
+		{
+		case '"': value.push_back('"'); break;
+		case '\\': value.push_back('\\'); break;
+		case '/': value.push_back('/'); break;
+		case 'b': value.push_back('\b'); break;
+		case 'f': value.push_back('\f'); break;
+		case 'n': value.push_back('\n'); break;
+		case 'r': value.push_back('\r'); break;
+		case 't': value.push_back('\t'); break;
+		case 'u':
+		{
+			if (end - p < 4)
+				return false;
+			unsigned int codePoint(ParseHex4(p));
+			p += 4;
+			if (codePoint >= 0xD800 && codePoint <= 0xDBFF)// Surrogate pair
+			{
+				if (end - p < 6 || p[0] != '\\' || p[1] != 'u')
+					return false;
+				const unsigned int low(ParseHex4(p + 2));
+				if (low < 0xDC00 || low > 0xDFFF)
+					return false;
+				p += 6;
+				codePoint = 0x10000 + (((codePoint & 0x3FF) << 10) | (low & 0x3FF));
+			}
+			else if (codePoint > 0xFFFF || (codePoint >= 0xDC00 && codePoint <= 0xDFFF))
+				return false;
+
+			AppendUTF8(value, codePoint);
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,127 @@
+// File:  jsonTape.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Two-stage JSON parser.  The first stage locates every structural
+//        character and records a compact tape of value positions, with jump
+//        offsets past each container.  Values are only converted (unescaped,
+//        number-parsed) when they are requested, so unused subtrees cost O(1).
+
+#ifndef JSON_TAPE_H_
+#define JSON_TAPE_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Local headers
+#include "jsonParseLimits.h"
+
+class JSONTapeNode;
+
+class JSONTape
+{
+public:
+	enum class Type : unsigned char
+	{
+		Object,
+		Array,
+		String,
+		Number,
+		True,
+		False,
+		Null
+	};
+
+	struct Entry
+	{
+		uint32_t offset;// Position of the first character of the value (strings: first character after the quote)
+		uint32_t extent;// Containers:  index of the entry following the container; others:  length in characters
+		uint32_t count;// Containers:  number of elements or members
+		Type type;
+		bool escaped;// Strings:  true if the string contains escape sequences
+	};
+
+	// The text must remain valid (and unmodified) for as long as the tape is used
+	bool Parse(const char* text, const size_t& length);
+	bool Parse(const std::string& text) { return Parse(text.data(), text.length()); }
+
+	void SetLimits(const JSONParseLimits& newLimits) { limits = newLimits; }
+
+	bool IsValid() const { return valid; }
+	JSONParseError GetError() const { return error; }
+	size_t GetErrorOffset() const { return errorOffset; }
+
+	JSONTapeNode GetRoot() const;
+
+private:
+	friend class JSONTapeNode;
+
+	const char* text = nullptr;
+	bool valid = false;
+	JSONParseError error = JSONParseError::None;
+	size_t errorOffset = 0;
+	JSONParseLimits limits;
+
+	// Retained between calls to Parse() so repeated parses don't reallocate
+	std::vector<Entry> entries;
+	std::vector<uint32_t> openContainers;
+
+	bool Fail(const char* position, const JSONParseError& reason = JSONParseError::Syntax);
+	bool ScanString(const char*& position, const char* end, Entry& entry);
+};
+
+// Lightweight cursor into a tape.  Default-constructed (or not-found) nodes
+// are invalid; all accessors fail gracefully on invalid nodes.
+class JSONTapeNode
+{
+public:
+	JSONTapeNode() = default;
+
+	bool IsValid() const { return tape != nullptr; }
+	JSONTape::Type GetType() const;
+	bool Is(const JSONTape::Type& type) const { return IsValid() && GetType() == type; }
+
+	// Number of elements (arrays) or members (objects)
+	size_t GetSize() const;
+
+	// For arrays, the first element; for objects, the first key (the value is
+	// obtained with GetValue() and the next key with GetValue().GetNext())
+	JSONTapeNode GetFirstChild() const;
+	JSONTapeNode GetNext() const;
+	JSONTapeNode GetValue() const;
+
+	JSONTapeNode GetMember(const char* key, const size_t& length) const;
+	JSONTapeNode GetMember(const std::string& key) const { return GetMember(key.data(), key.length()); }
+	JSONTapeNode GetElement(size_t index) const;
+
+	// Raw (still escaped) characters of a string or number
+	const char* GetRaw() const;
+	size_t GetRawLength() const;
+	bool IsEscaped() const;// True if the raw characters differ from the string value
+
+	// Materialization
+	bool GetString(std::string& value) const;
+	bool GetNumber(int& value) const;
+	bool GetNumber(unsigned int& value) const;
+	bool GetNumber(uint64_t& value) const;
+	bool GetNumber(double& value) const;
+	bool GetBool(bool& value) const;
+
+private:
+	friend class JSONTape;
+	JSONTapeNode(const JSONTape* tape, const uint32_t& index, const uint32_t& end)
+		: tape(tape), index(index), end(end) {}
+
+	const JSONTape* tape = nullptr;
+	uint32_t index = 0;
+	uint32_t end = 0;// Index of the entry following the parent container
+
+	const JSONTape::Entry& GetEntry() const { return tape->entries[index]; }
+	uint32_t GetFollowingIndex() const;
+};
+
+// Converts the (escaped) contents of a JSON string to UTF-8
+bool UnescapeJSONString(const char* begin, const char* end, std::string& value);
+
+#endif// JSON_TAPE_H_
@@ -0,0 +1,227 @@
+// File:  jsonWriter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming JSON serializer.  Output is appended to a single growable
+//        buffer (or staged in one and flushed to a file), so no intermediate
+//        strings are built for individual values.
+
+// Local headers
+#include "jsonWriter.h"
+
+// Standard C++ headers
+#include <charconv>
+#include <cmath>
+
+JSONWriter::JSONWriter(std::string& buffer, const bool& pretty)
+	: buffer(buffer), file(nullptr), pretty(pretty)
+{
+}
+
+JSONWriter::JSONWriter(FILE* file, const bool& pretty)
+	: buffer(ownBuffer), file(file), pretty(pretty)
+{
+	ownBuffer.reserve(flushThreshold + 1024);
+}
+
+JSONWriter::~JSONWriter()
+{
+	Flush();
+}
+
+bool JSONWriter::Flush()
+{
+	if (!file)
+		return true;
+
+	if (!buffer.empty())
+	{
+		if (fwrite(buffer.data(), 1, buffer.length(), file) != buffer.length())
+			writeFailed = true;
+		buffer.clear();
+	}
+
+	return !writeFailed;
+}
+
+void JSONWriter::Written()
+{
+	if (file && buffer.length() >= flushThreshold)
+		Flush();
+}
+
+void JSONWriter::NewLine()
+{
+	buffer.push_back('\n');
+	buffer.append(hasElements.size(), '\t');
+}
+
+void JSONWriter::BeginValue()
+{
+	if (afterKey)
+	{
+		afterKey = false;
+		return;
+	}
+
+	if (hasElements.empty())
+		return;
+
+	if (hasElements.back())
+		buffer.push_back(',');
+	hasElements.back() = true;
+
+	if (pretty)
+		NewLine();
+}
+
+void JSONWriter::Open(const char& c)
+{
+	BeginValue();
+	buffer.push_back(c);
+	hasElements.push_back(false);
+}
+
+void JSONWriter::Close(const char& c)
+{
+	const bool hadElements(hasElements.back());
+	hasElements.pop_back();
+	if (pretty && hadElements)
+		NewLine();
+	buffer.push_back(c);
+	Written();
+}
+
+void JSONWriter::StartObject()
+{
+	Open('{');
+}
+
+void JSONWriter::EndObject()
+{
+	Close('}');
+}
+
+void JSONWriter::StartArray()
+{
+	Open('[');
+}
+
+void JSONWriter::EndArray()
+{
+	Close(']');
+}
+
+void JSONWriter::Key(const char* key, const size_t& length)
+{
+	BeginValue();
+	AppendEscaped(key, length);
+	buffer.push_back(':');
+	if (pretty)
+		buffer.push_back(' ');
+	afterKey = true;
+}
+
+void JSONWriter::String(const char* value, const size_t& length)
+{
+	BeginValue();
+	AppendEscaped(value, length);
+	Written();
+}
+
+void JSONWriter::AppendEscaped(const char* value, const size_t& length)
+{
+	static const char hexDigits[] = "0123456789abcdef";
+
+	buffer.push_back('"');
+	const char* const end(value + length);
+	while (value < end)
+	{
+		// Copy the run of characters that need no escaping in one go
+		const char* run(value);
+		while (value < end && *value != '"' && *value != '\\'
+			&& static_cast<unsigned char>(*value) >= 0x20)
+			++value;
+		buffer.append(run, value);
+		if (value == end)
+			break;
+
+		const char c(*value++);
+		buffer.push_back('\\');
+		switch (c)
+		{
+		case '"': buffer.push_back('"'); break;
+		case '\\': buffer.push_back('\\'); break;
+		case '\b': buffer.push_back('b'); break;
+		case '\f': buffer.push_back('f'); break;
+		case '\n': buffer.push_back('n'); break;
+		case '\r': buffer.push_back('r'); break;
+		case '\t': buffer.push_back('t'); break;
+		default:
+			buffer.append("u00");
+			buffer.push_back(hexDigits[(c >> 4) & 0xF]);
+			buffer.push_back(hexDigits[c & 0xF]);
+		}
+	}
+	buffer.push_back('"');
+}
+
+void JSONWriter::Number(const int& value)
+{
+	BeginValue();
+	char digits[16];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	Written();
+}
+
+void JSONWriter::Number(const unsigned int& value)
+{
+	BeginValue();
+	char digits[16];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	Written();
+}
+
+void JSONWriter::Number(const int64_t& value)
+{
+	BeginValue();
+	char digits[24];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	Written();
+}
+
+void JSONWriter::Number(const uint64_t& value)
+{
+	BeginValue();
+	char digits[24];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	Written();
+}
+
+void JSONWriter::Number(const double& value)
+{
+	// JSON has no representation for infinity or NaN
+	if (!std::isfinite(value))
+	{
+		Null();
+		return;
+	}
+
+	BeginValue();
+	char digits[32];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	Written();
+}
+
+void JSONWriter::Bool(const bool& value)
+{
+	BeginValue();
+	buffer.append(value ? "true" : "false");
+	Written();
+}
+
+void JSONWriter::Null()
+{
+	BeginValue();
+	buffer.append("null");
+	Written();
+}
@@ -0,0 +1,92 @@
+// File:  jsonWriter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Streaming JSON serializer.  Output is appended to a single growable
+//        buffer (or staged in one and flushed to a file), so no intermediate
+//        strings are built for individual values.
+
+#ifndef JSON_WRITER_H_
+#define JSON_WRITER_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+class JSONWriter
+{
+public:
+	// Appends to the specified string
+	explicit JSONWriter(std::string& buffer, const bool& pretty = false);
+	// Writes to the specified file, which remains owned by the caller
+	explicit JSONWriter(FILE* file, const bool& pretty = false);
+	~JSONWriter();
+
+	JSONWriter(const JSONWriter&) = delete;
+	JSONWriter& operator=(const JSONWriter&) = delete;
+
+	void StartObject();
+	void EndObject();
+	void StartArray();
+	void EndArray();
+
+	// Within objects, each value must be preceded by its key
+	void Key(const char* key, const size_t& length);
+	void Key(const std::string& key) { Key(key.data(), key.length()); }
+
+	void String(const char* value, const size_t& length);
+	void String(const std::string_view& value) { String(value.data(), value.length()); }
+	void Number(const int& value);
+	void Number(const unsigned int& value);
+	void Number(const int64_t& value);
+	void Number(const uint64_t& value);
+	void Number(const double& value);
+	void Bool(const bool& value);
+	void Null();
+
+	// Shorthand for Key() followed by the value
+	template<typename T>
+	void Member(const char* key, const T& value);
+	void Member(const char* key, const char* value) { Key(key, strlen(key)); String(value, strlen(value)); }
+
+	// Only meaningful for file output; returns false if any write has failed
+	bool Flush();
+
+private:
+	std::string ownBuffer;
+	std::string& buffer;
+	FILE* const file;
+	const bool pretty;
+	bool writeFailed = false;
+
+	// One entry per open container; true once the container has an element
+	std::vector<bool> hasElements;
+	bool afterKey = false;
+
+	static const size_t flushThreshold = 64 * 1024;
+
+	void BeginValue();
+	void Open(const char& c);
+	void Close(const char& c);
+	void NewLine();
+	void AppendEscaped(const char* value, const size_t& length);
+	void Written();
+};
+
+template<typename T>
+void JSONWriter::Member(const char* key, const T& value)
+{
+	Key(key, strlen(key));
+	if constexpr (std::is_same<T, std::string>::value || std::is_same<T, std::string_view>::value)
+		String(value);
+	else if constexpr (std::is_same<T, bool>::value)
+		Bool(value);
+	else
+		Number(value);
+}
+
+#endif// JSON_WRITER_H_
@@ -7,18 +7,97 @@
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
-#include <sstream>
 #include <cmath>
 #include <fstream>
 #include <map>
+#include <filesystem>
+#include <future>
+#include <charconv>
+#include <memory>
+#include <algorithm>
+#include <cstdio>
 
 // Local headers
 #include "gitHubInterface.h"
 #include "oAuth2Interface.h"
+#include "statsExport.h"
+#include "statsWriter.h"
+#include "assetTable.h"
+#include "checkedMath.h"
+#include "assetClassifier.h"
+#include "countShards.h"
+#include "countHistory.h"
+#include "countArchive.h"
+#include "countRollups.h"
+#include "countQuery.h"
+#include "mappedFile.h"
+#include "countDelta.h"
+#include "tableRenderer.h"
+#include "durableWrite.h"
 
 static const std::string userAgent("gitHubStats/1.0");
 static const std::string oAuthFileName("oAuthInfo");
-static const std::string lastCountsFileName("lastCounts");
+static const std::string lastCountsFileName("lastCounts");// Legacy text format
+static const std::string assetRulesFileName("assetRules");
+
+// One set of count files per owner, so owners' repos never collide
+static const CountShards countShards("counts");
+
+// Archiving runs in the background while the API requests are in flight
+static std::future<void> historyMaintenance;
+
+void MaintainHistory(const std::string& historyFileName, const std::string& archiveFileName)
+{
+	if (!CountArchive::Append(archiveFileName, historyFileName))
+		std::cerr << "Failed to archive '" << historyFileName << "'\n";
+}
+
+// Saves the observations that are new or have changed, both to the owner's
+// history and to the store (for the next comparison), and adds the deltas to
+// the owner's rollups
+void RecordChanges(const std::string& owner, CountStore& store, const std::vector<CountSnapshot::Entry>& current,
+	const std::vector<CountDelta::Delta>& deltas)
+{
+	const std::string historyFileName(countShards.GetHistoryFileName(owner));
+	if (historyMaintenance.valid())
+		historyMaintenance.get();
+
+	std::vector<CountSnapshot::Entry> changes;
+	std::vector<CountHistory::Sample> samples;
+	for (size_t i = 0; i < current.size(); ++i)
+	{
+		if (!CountDelta::IsChange(current[i], deltas[i]))
+			continue;
+		changes.push_back(current[i]);
+		samples.push_back({ current[i].repo, current[i].tag, current[i].asset, current[i].count, current[i].flags });
+	}
+
+	if (changes.empty())
+		return;
+
+	const int64_t time(Timestamp::Now().GetSeconds());
+	if (!CountHistory::Append(historyFileName, time, samples))
+		std::cerr << "Failed to record download history\n";
+	if (!store.Update(changes))
+	{
+		// The next poll sees the same deltas, so they're added then instead
+		std::cerr << "Failed to save download counts\n";
+		return;
+	}
+
+	const std::string rollupFileName(countShards.GetRollupFileName(owner));
+	const FileLock lock(rollupFileName);
+	CountRollups rollups;
+	if (!lock.IsLocked() || !rollups.Load(rollupFileName))
+	{
+		std::cerr << "Failed to read download rollups\n";
+		return;
+	}
+
+	rollups.Add(time, current, deltas);
+	if (!rollups.Save(rollupFileName))
+		std::cerr << "Failed to save download rollups\n";
+}
 
 bool GetGitHubUser(std::string& user)
 {
@@ -47,8 +126,8 @@ bool GetGitHubRepo(GitHubInterface& github,
 		size_t maxNameLen(0);
 		for (size_t i = 0; i < repoList.size(); i++)
 		{
-			if (repoList[i].name.length() > maxNameLen)
-				maxNameLen = repoList[i].name.length();
+			if (repoList[i].name.Length() > maxNameLen)
+				maxNameLen = repoList[i].name.Length();
 		}
 
 		for (size_t i = 0; i < repoList.size(); i++)
@@ -72,7 +151,7 @@ bool GetGitHubRepo(GitHubInterface& github,
 
 	for (size_t i = 0; i < repoList.size(); i++)
 	{
-		if (repoList[i].name.compare(repoName) == 0)
+		if (repoList[i].name.View() == repoName)
 		{
 			repo = i;
 			return true;
@@ -82,57 +161,112 @@ bool GetGitHubRepo(GitHubInterface& github,
 	return false;
 }
 
-void PrintRepoData(const GitHubInterface::RepoInfo& repoData)
+// Text output is appended to one string and written at once, rather than
+// streamed field by field
+template<typename T>
+void AppendNumber(std::string& out, const T& value)
+{
+	char digits[24];
+	out.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr - digits);
+}
+
+void AppendTime(std::string& out, const Timestamp& time)
 {
-	std::cout << "\nProject:      " << repoData.name;
-	std::cout << "\nDescription:  " << repoData.description;
-	std::cout << "\nLanguage:     " << repoData.language;
-	std::cout << "\nCreated:      " << repoData.creationTime;
-	std::cout << "\nUpdated:      " << repoData.lastUpdateTime << std::endl;
+	char text[Timestamp::maxLength];
+	out.append(text, time.Format(text));
 }
 
-std::string GetPrettyFileSize(const unsigned int& bytes)
+void AppendRepoData(const GitHubInterface::RepoInfo& repoData, std::string& out)
 {
-	std::ostringstream ss;
+	out.append("\nProject:      ").append(repoData.name.View());
+	out.append("\nDescription:  ").append(repoData.description);
+	out.append("\nLanguage:     ").append(repoData.language.View());
+	out.append("\nCreated:      ");
+	AppendTime(out, repoData.creationTime);
+	out.append("\nUpdated:      ");
+	AppendTime(out, repoData.lastUpdateTime);
+	out.push_back('\n');
+}
 
+void AppendPrettyFileSize(const uint64_t& bytes, std::string& out)
+{
 	const double threshold(0.75);
-	const unsigned int rollover(1024);
-	if (bytes < rollover * rollover)
-		ss << bytes << " bytes";
-	else
+	const double rollover(1024.0);
+	const double value(static_cast<double>(bytes));
+	if (value < rollover * threshold)
 	{
-		ss.precision(2);
-		if (bytes < pow(rollover, 2) * threshold)
-			ss << std::fixed << bytes / rollover << " kB";
-		else if (bytes < pow(rollover, 3) * threshold)
-			ss << std::fixed << bytes / pow(rollover, 2) << " MB";
-		else if (bytes < pow(rollover, 4) * threshold)
-			ss << std::fixed << bytes / pow(rollover, 4) << " GB";
-		else// if (bytes < pow(rollover, 5) * threshold)
-			ss << std::fixed << bytes / pow(rollover, 5) << " TB";
+		AppendNumber(out, bytes);
+		out.append(" bytes");
+		return;
 	}
 
-	return ss.str();
+	const char* units[] = { "kB", "MB", "GB", "TB" };
+	size_t unit(0);
+	while (unit < 3 && value >= pow(rollover, unit + 2) * threshold)
+		++unit;
+
+	char text[64];
+	const int length(snprintf(text, sizeof(text), "%.2f %s", value / pow(rollover, unit + 1), units[unit]));
+	if (length > 0)
+		out.append(text, std::min(static_cast<size_t>(length), sizeof(text) - 1));
 }
 
-typedef std::map<std::string, unsigned int> AssetDownloadCountMap;
+// Keyed on interned names, so lookups compare ids rather than strings (note that
+// iteration order is therefore order of first appearance, not alphabetical)
+typedef std::map<InternedString, uint64_t> AssetDownloadCountMap;
 struct TagDownloadCountMap// Name is too long (generates C4503) if we use a typedef here
 {
-	std::map<std::string, AssetDownloadCountMap> assetCountMap;
+	std::map<InternedString, AssetDownloadCountMap> assetCountMap;
 };
-typedef std::map<std::string, TagDownloadCountMap> RepoTagInfoMap;
+typedef std::map<InternedString, TagDownloadCountMap> RepoTagInfoMap;
+
+// Whitespace-separated, as written by the former WriteLastCountData (and
+// read by >> before that)
+bool NextToken(const char*& p, const char* end, std::string_view& token)
+{
+	const auto isSpace([](const char& c)
+	{
+		return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+	});
+
+	while (p != end && isSpace(*p))
+		++p;
+
+	const char* const start(p);
+	while (p != end && !isSpace(*p))
+		++p;
+
+	token = std::string_view(start, p - start);
+	return !token.empty();
+}
+
+template<typename T>
+bool NextNumber(const char*& p, const char* end, T& value)
+{
+	std::string_view token;
+	if (!NextToken(p, end, token))
+		return false;
+
+	const auto result(std::from_chars(token.data(), token.data() + token.length(), value));
+	return result.ec == std::errc() && result.ptr == token.data() + token.length();
+}
 
+// Tokenizes the mapped file in place; names are interned straight from views
+// into the mapping
 bool ReadLastCountData(RepoTagInfoMap& data)
 {
-	std::ifstream file(lastCountsFileName.c_str());
-	if (!file.is_open() || !file.good())
+	MappedFile file;
+	if (!file.Open(lastCountsFileName))
 	{
 		std::cerr << "Failed to open '" << lastCountsFileName << "' for input\n";
 		return false;
 	}
 
+	const char* p(file.GetData());
+	const char* const end(p + file.GetSize());
+
 	unsigned int repoCount;
-	if (!(file >> repoCount).good())
+	if (!NextNumber(p, end, repoCount))
 	{
 		std::cerr << "Failed to read repository count\n";
 		return false;
@@ -140,42 +274,50 @@ bool ReadLastCountData(RepoTagInfoMap& data)
 
 	for (unsigned int i = 0; i < repoCount; ++i)
 	{
-		std::string repoName;
-		file >> repoName;
+		std::string_view repoName;
+		NextToken(p, end, repoName);
 
 		unsigned int releaseCount;
-		if (!(file >> releaseCount).good())
+		if (!NextNumber(p, end, releaseCount))
 		{
 			std::cerr << "Failed to read release count for repository '" << repoName << "\n";
 			return false;
 		}
 
+		// Entries are only created once an asset is read, as empty releases
+		// have nothing to import
+		const InternedString repo(repoName);
+
 		for (unsigned int j = 0; j < releaseCount; ++j)
 		{
-			std::string releaseTag;
-			file >> releaseTag;
+			std::string_view releaseTag;
+			NextToken(p, end, releaseTag);
 
 			unsigned int k, assetCount;
-			if (!(file >> assetCount).good())
+			if (!NextNumber(p, end, assetCount))
 			{
 				std::cerr << "Failed to read asset count for release '" << releaseTag << "' in repository '" << repoName << "\n";
 				return false;
 			}
 
+			AssetDownloadCountMap* releaseData(nullptr);
+
 			for (k = 0; k < assetCount; ++k)
 			{
-				std::string assetName;
-				file >> assetName;
-				
-				unsigned int count;
-				if (!(file >> count).good())
+				std::string_view assetName;
+				NextToken(p, end, assetName);
+
+				uint64_t count;
+				if (!NextNumber(p, end, count))
 				{
 					std::cerr << "Failed to read download count for asset '" << assetName
 						<< "' from release '" << releaseTag << "' in repository '" << repoName << "\n";
 					return false;
 				}
 
-				data[repoName].assetCountMap[releaseTag][assetName] = count;
+				if (!releaseData)
+					releaseData = &data[repo].assetCountMap[InternedString(releaseTag)];
+				(*releaseData)[InternedString(assetName)] = count;
 			}
 		}
 	}
@@ -183,266 +325,293 @@ bool ReadLastCountData(RepoTagInfoMap& data)
 	return true;
 }
 
-bool WriteLastCountData(const RepoTagInfoMap& data)
+// The legacy text file didn't record owners, so it's only imported when the
+// user names the owner it belongs to (--import-counts), and only into a new shard
+bool ImportLegacyCounts(const std::string& owner)
 {
-	std::ofstream file(lastCountsFileName.c_str());
-	if (!file.is_open() || !file.good())
+	if (countShards.Exists(owner))
 	{
-		std::cerr << "Failed to open '" << lastCountsFileName << "' for output\n";
+		std::cerr << "Counts are already stored for '" << owner << "'; not importing '" << lastCountsFileName << "'\n";
 		return false;
 	}
 
-	file << data.size() << '\n';
-	for (const auto& repoIter : data)
-	{
-		file << repoIter.first << '\n';
-		file << repoIter.second.assetCountMap.size() << '\n';
+	RepoTagInfoMap legacyData;
+	if (!ReadLastCountData(legacyData))
+		return false;
 
+	std::vector<CountSnapshot::Entry> entries;
+	for (const auto& repoIter : legacyData)
+	{
 		for (const auto& releaseIter : repoIter.second.assetCountMap)
 		{
-			file << releaseIter.first << '\n';
-			file << releaseIter.second.size() << '\n';
+			if (releaseIter.second.empty())
+				continue;
 
+			// Mark the asset that the legacy format implied was counted
+			const auto* bestAsset(&*releaseIter.second.begin());
+			AssetClassifier::Priority bestPriority(AssetClassifier::Get().Classify(bestAsset->first));
 			for (const auto& assetIter : releaseIter.second)
 			{
-				file << assetIter.first << '\n';
-				file << assetIter.second << '\n';
+				const AssetClassifier::Priority priority(AssetClassifier::Get().Classify(assetIter.first));
+				if (&assetIter != bestAsset && AssetClassifier::Prefer(priority, bestPriority))
+				{
+					bestAsset = &assetIter;
+					bestPriority = priority;
+				}
 			}
+
+			for (const auto& assetIter : releaseIter.second)
+				entries.push_back({ repoIter.first.View(), releaseIter.first.View(), assetIter.first.View(),
+					assetIter.second, &assetIter == bestAsset ? CountSnapshot::Counted : 0u });
 		}
 	}
 
-	file << std::endl;
+	const std::string snapshotFileName(countShards.GetSnapshotFileName(owner));
+	if (!countShards.Register(owner) || !CountSnapshot::Write(snapshotFileName, nullptr, entries))
+		return false;
 
+	std::cerr << "Imported '" << lastCountsFileName << "' into '" << snapshotFileName << "'" << std::endl;
 	return true;
 }
 
-void PrintReleaseData(const std::vector<GitHubInterface::ReleaseData>& releaseData, const std::string& repoName, const bool& compare)
+bool OpenCountStore(const std::string& owner, CountStore& store)
+{
+	if (!countShards.Exists(owner) && std::filesystem::exists(lastCountsFileName))
+		std::cerr << "Warning:  '" << lastCountsFileName << "' was not imported; if it holds the counts for '"
+			<< owner << "', run again with --import-counts\n";
+
+	return countShards.Open(owner, store);
+}
+
+// Prints the releases after any text already in out, with a single write, or
+// writes each release through the writer if there is one
+void PrintReleaseData(const std::vector<GitHubInterface::ReleaseData>& releaseData,
+	const std::string& owner, const InternedString& repoName, const bool& compare, StatsWriter* writer,
+	std::string& out)
 {
-	RepoTagInfoMap downloadData;
-	if (compare && !ReadLastCountData(downloadData))
-		std::cerr << "Failed to read comparison data; assuming zero previous downloads\n";
+	CountStore previous;
+	std::vector<CountSnapshot::Entry> current;
+	std::vector<CountDelta::Delta> deltas;
+	if (compare)
+	{
+		if (!OpenCountStore(owner, previous))
+			std::cerr << "Failed to read comparison data; assuming zero previous downloads\n";
+
+		for (const auto& release : releaseData)
+		{
+			size_t countedAsset(0);
+			for (size_t i = 1; i < release.assets.size(); ++i)
+			{
+				if (AssetClassifier::Prefer(release.assets[i].priority, release.assets[countedAsset].priority))
+					countedAsset = i;
+			}
 
-	std::cout << "\n" << releaseData.size() << " release(s)" << std::endl;
-	unsigned int total(0), totalDelta(0);
+			for (size_t i = 0; i < release.assets.size(); ++i)
+				current.push_back({ repoName.View(), release.tag.View(), release.assets[i].name.View(),
+					release.assets[i].downloadCount, i == countedAsset ? CountSnapshot::Counted : 0u });
+		}
+
+		CountDelta::Compute(previous, current, deltas);
+	}
+
+	if (writer)
+	{
+		std::vector<int64_t> releaseDeltas;
+		size_t observation(0);
+		for (const auto& release : releaseData)
+		{
+			releaseDeltas.clear();
+			for (size_t i = 0; compare && i < release.assets.size(); ++i)
+				releaseDeltas.push_back(deltas[observation++].change);
+			writer->WriteRelease(repoName, release, compare ? &releaseDeltas : nullptr);
+		}
+
+		if (compare)
+			RecordChanges(owner, previous, current, deltas);
+		return;
+	}
+
+	// Formatted as a whole and written at once, rather than flushed per line
+	out.push_back('\n');
+	AppendNumber(out, releaseData.size());
+	out.append(" release(s)\n");
+	uint64_t total(0);
+	int64_t totalDelta(0);
+	bool overflow(false);
+	size_t observation(0);
 	for (const auto& release : releaseData)
 	{
-		std::cout << "\n\nTag:      " << release.tag;
-		std::cout << "\nCreated:  " << release.creationTime;
+		out.append("\n\nTag:      ").append(release.tag.View());
+		out.append("\nCreated:  ");
+		AppendTime(out, release.creationTime);
 
 		if (release.assets.size() > 0)
 		{
-			std::cout << "\n" << release.assets.size() << " associated file(s)";
+			out.push_back('\n');
+			AppendNumber(out, release.assets.size());
+			out.append(" associated file(s)");
 			for (const auto& asset : release.assets)
 			{
-				std::cout << "\nFile name:         " << asset.name;
-				std::cout << "\n  Size:            " << GetPrettyFileSize(asset.fileSize);
-				std::cout << "\n  Download Count:  " << asset.downloadCount;
+				out.append("\nFile name:         ").append(asset.name.View());
+				out.append("\n  Size:            ");
+				AppendPrettyFileSize(asset.fileSize, out);
+				out.append("\n  Download Count:  ");
+				AppendNumber(out, asset.downloadCount);
 
 				if (compare)
 				{
-					const unsigned int lastCount([downloadData, repoName, release, asset]()
-					{
-						auto repoIter(downloadData.find(repoName));
-						if (repoIter == downloadData.end())
-							return 0U;
-
-						auto releaseIter(repoIter->second.assetCountMap.find(release.tag));
-						if (releaseIter == repoIter->second.assetCountMap.end())
-							return 0U;
-
-						auto assetIter(releaseIter->second.find(asset.name));
-						if (assetIter == releaseIter->second.end())
-							return 0U;
-
-						return assetIter->second;
-					}());
-					const unsigned int delta(asset.downloadCount - lastCount);
-					totalDelta += delta;
+					const int64_t delta(deltas[observation++].change);
+					overflow |= !CheckedAdd(totalDelta, delta);
 					if (delta > 0)
-						std::cout << " (+" << delta << ")";
-					downloadData[repoName].assetCountMap[release.tag][asset.name] = asset.downloadCount;
+					{
+						out.append(" (+");
+						AppendNumber(out, delta);
+						out.push_back(')');
+					}
 				}
 
-				std::cout << std::endl;
-				total += asset.downloadCount;
+				out.push_back('\n');
+				overflow |= !CheckedAdd(total, asset.downloadCount);
 			}
 		}
 	}
 
-	std::cout << std::endl;
-	std::cout << "Total downloads:  " << total;
+	out.append("\nTotal downloads:  ");
+	AppendNumber(out, total);
 
 	if (compare && totalDelta > 0)
-		std::cout << " (+" << totalDelta << ")";
+	{
+		out.append(" (+");
+		AppendNumber(out, totalDelta);
+		out.push_back(')');
+	}
+
+	out.push_back('\n');
+	if (!TableRenderer::WriteAll(stdout, out))
+		std::cerr << "Failed to write the release data\n";
 
-	std::cout << std::endl;
+	if (overflow)
+		std::cerr << "Warning:  Download totals exceed the counter range and have been clamped" << std::endl;
 
 	if (compare)
-		WriteLastCountData(downloadData);
+	{
+		RecordChanges(owner, previous, current, deltas);
+	}
 }
 
-void GetStats(GitHubInterface& github, GitHubInterface::RepoInfo repo, const bool& compare)
+void GetStats(GitHubInterface& github, GitHubInterface::RepoInfo repo, const std::string& owner,
+	const bool& compare, const std::string& exportFileName, StatsWriter* writer)
 {
 	std::vector<GitHubInterface::ReleaseData> releaseData;
 	if (!github.GetRepoData(repo, &releaseData))
 		return;
 
-	PrintRepoData(repo);
-	PrintReleaseData(releaseData, repo.name, compare);
+	std::string out;
+	if (!writer)
+		AppendRepoData(repo, out);
+	PrintReleaseData(releaseData, owner, repo.name, compare, writer, out);
+
+	if (!exportFileName.empty())
+		ExportStats(exportFileName, std::vector<GitHubInterface::RepoInfo>(1, repo),
+			std::vector<std::vector<GitHubInterface::ReleaseData>>(1, releaseData));
 }
 
-void GetAllStats(GitHubInterface& github, std::vector<GitHubInterface::RepoInfo>& repoList, const bool& compare)
+// Prints a table, or writes each repo through the writer if there is one
+void GetAllStats(GitHubInterface& github, std::vector<GitHubInterface::RepoInfo>& repoList,
+	const std::string& owner, const bool& compare, const std::string& exportFileName, StatsWriter* writer)
 {
-	std::vector<std::vector<GitHubInterface::ReleaseData>> releaseData(repoList.size());
 	unsigned int i;
-	for (i = 0; i < repoList.size(); i++)
-	{
-		const auto tee(repoList[i].lastUpdateTime.find('T'));
-		if (tee != std::string::npos)
-			repoList[i].lastUpdateTime = repoList[i].lastUpdateTime.substr(0, tee);
-		github.GetRepoData(repoList[i], &releaseData[i]);
-	}
-
-	const std::string repoNameHeading("Repo Name");
-	const std::string dateHeading("Last Update");
-	const std::string languageHeading("Language");
-	const std::string releaseCountHeading("Releases");
-	const std::string totalDownloadCountHeading("Total");
-	const std::string latestDownloadCountHeading("Latest");
-	const std::string deltaCountHeading("Delta");
-
-	size_t maxNameLen(repoNameHeading.length());
-	size_t maxLangLen(languageHeading.length());
-	size_t maxDateLen(dateHeading.length());
-	size_t maxReleaseCountLen(releaseCountHeading.length());
-	size_t maxTotalDownloadCountLen(totalDownloadCountHeading.length());
-	size_t maxLatestDownloadCountLen(latestDownloadCountHeading.length());
-	size_t maxDeltaCountLen(deltaCountHeading.length());
-
-	for (const auto& repo : repoList)
+	AssetTable assets;
+	if (exportFileName.empty())
+		github.GetRepoData(repoList, assets);
+	else
 	{
-		if (!repo.hasReleases)
-			continue;
-
-		if (repo.name.length() > maxNameLen)
-			maxNameLen = repo.name.length();
-
-		if (repo.language.length() > maxLangLen)
-			maxLangLen = repo.language.length();
-
-		if (repo.lastUpdateTime.length() > maxDateLen)
-			maxDateLen = repo.lastUpdateTime.length();
+		// Export needs the full records, so build the table from those instead
+		std::vector<std::vector<GitHubInterface::ReleaseData>> releaseData;
+		github.GetRepoData(repoList, releaseData);
+		ExportStats(exportFileName, repoList, releaseData);
+		for (i = 0; i < repoList.size(); i++)
+			assets.Append(i, releaseData[i]);
 	}
 
-	std::cout << std::left << std::setw(maxNameLen)
-		<< std::setfill(' ') << repoNameHeading << "  ";
-	std::cout << std::left << std::setw(maxDateLen)
-		<< std::setfill(' ') << dateHeading << "  ";
-	std::cout << std::left << std::setw(maxLangLen)
-		<< std::setfill(' ') << languageHeading << "  ";
-	std::cout << std::left << std::setw(maxReleaseCountLen)
-		<< std::setfill(' ') << releaseCountHeading << "  ";
-	std::cout << std::left << std::setw(maxTotalDownloadCountLen)
-		<< std::setfill(' ') << totalDownloadCountHeading << "  ";
-	std::cout << std::left << std::setw(maxLatestDownloadCountLen)
-		<< std::setfill(' ') << latestDownloadCountHeading;
+	TableRenderer table;
+	table.AddColumn("Repo Name");
+	table.AddColumn("Last Update");
+	table.AddColumn("Language");
+	table.AddColumn("Releases");
+	table.AddColumn("Total");
+	table.AddColumn("Latest");
+	if (compare)
+		table.AddColumn("Delta");
+	if (!writer)
+		table.Reserve(repoList.size(), 64);
 
-	size_t width(maxNameLen + maxDateLen + maxLangLen
-		+ maxReleaseCountLen + maxTotalDownloadCountLen
-		+ maxLatestDownloadCountLen + 10);
+	CountStore previous;
+	std::vector<CountSnapshot::Entry> current;
 	if (compare)
 	{
-		std::cout << "  " << std::left << std::setw(maxDeltaCountLen)
-			<< std::setfill(' ') << deltaCountHeading;
-		width += 2 + maxDeltaCountLen;
-	}
-	std::cout << '\n';
+		if (!OpenCountStore(owner, previous))
+			std::cerr << "Failed to read comparison data; assuming zero previous downloads\n";
 
-	std::cout << std::setw(width)
-		<< std::setfill('-') << '-' << std::endl;
-
-	RepoTagInfoMap downloadData;
-	if (compare && !ReadLastCountData(downloadData))
-		std::cerr << "Failed to read comparison data; assuming zero previous downloads\n";
+		current.reserve(assets.GetRowCount());
+		for (i = 0; i < repoList.size(); i++)
+		{
+			size_t begin, end;
+			assets.GetRowRange(i, begin, end);
+			// Every asset, so a change of counted asset clears the old flag
+			for (size_t row = begin; row < end; ++row)
+				current.push_back({ repoList[i].name.View(), assets.GetTag(row).View(), assets.GetName(row).View(),
+					assets.GetDownloadCount(row), (assets.GetFlags(row) & AssetTable::Counted) ? CountSnapshot::Counted : 0u });
+		}
+	}
 
 	for (i = 0; i < repoList.size(); i++)
 	{
-		if (releaseData[i].size() > 0)
+		const AssetTable::RepoSummary summary(assets.Summarize(i));
+		if (summary.releaseCount > 0)
 		{
-			std::cout << std::left << std::setw(maxNameLen) << std::setfill(' ') << repoList[i].name << "  ";
-			std::cout << std::left << std::setw(maxDateLen) << std::setfill(' ') << repoList[i].lastUpdateTime << "  ";
-			std::cout << std::left << std::setw(maxLangLen) << std::setfill(' ') << repoList[i].language << "  ";
-			std::cout << std::left << std::setw(maxReleaseCountLen) << std::setfill(' ') << releaseData[i].size() << "  ";
-
-			auto repoCountIter(downloadData.find(repoList[i].name));
-			unsigned int lastDownloadCount(0);
-			if (repoCountIter != downloadData.end())
-			{
-				for (const auto& releaseCountIter : repoCountIter->second.assetCountMap)
-				{
-					const auto* bestAsset(&*releaseCountIter.second.begin());
-					for (const auto& assetCountIter : releaseCountIter.second)
-					{
-						if (GitHubInterface::IsBestAsset(assetCountIter.first))
-							bestAsset = &assetCountIter;
-					}
-
-					lastDownloadCount += bestAsset->second;
-				}
-			}
-
-			size_t fileCount(0), totalDownloadCount(0), latestDownloadCount(0);
-			time_t latestRelease(0);
-			for (const auto& release : releaseData[i])
-			{
-				fileCount += release.assets.size();
-				std::istringstream dateSS(release.creationTime);
-				struct std::tm tm;
-				dateSS >> std::get_time(&tm, "%Y-%m-%dT%X");
-				const time_t releaseDate(std::mktime(&tm));
-
-				// Best asset is the one that is an executable (or just take the first one)
-				auto bestAsset = release.assets.front();
-				for (const auto& asset : release.assets)
-				{
-					if (GitHubInterface::IsBestAsset(asset.name))
-						bestAsset = asset;
-				}
-
-				totalDownloadCount += bestAsset.downloadCount;
-				downloadData[repoList[i].name].assetCountMap[release.tag][bestAsset.name] = bestAsset.downloadCount;
-
-				if (difftime(latestRelease, releaseDate) < 0.0)
-				{
-					latestDownloadCount = bestAsset.downloadCount;
-					latestRelease = releaseDate;
-				}
-			}
-			
-			std::cout << std::left << std::setw(maxTotalDownloadCountLen) << std::setfill(' ') << totalDownloadCount << "  ";
-			std::cout << std::left << std::setw(maxLatestDownloadCountLen) << std::setfill(' ') << latestDownloadCount;
+			bool overflow(summary.overflow);
+			const uint64_t lastDownloadCount(CountDelta::GetCountedTotal(previous, repoList[i].name.View(), overflow));
+			const int64_t deltaDownloadCount(CheckedDifference(summary.totalDownloads, lastDownloadCount));
 
-			if (compare)
+			if (writer)
+				writer->WriteRepo(repoList[i], summary, compare ? &deltaDownloadCount : nullptr);
+			else
 			{
-				std::cout << "  " << std::left << std::setw(maxDeltaCountLen) << std::setfill(' ');
-				const size_t deltaDownloadCount(totalDownloadCount - lastDownloadCount);
-				if (deltaDownloadCount > 0)
-					std::cout << std::showpos << deltaDownloadCount << std::noshowpos;
-				else
-					std::cout << deltaDownloadCount;
+				char date[Timestamp::maxLength];
+				table.AddCell(repoList[i].name.View());
+				table.AddCell(std::string_view(date, repoList[i].lastUpdateTime.FormatDate(date)));
+				table.AddCell(repoList[i].language.View());
+				table.AddCell(static_cast<uint64_t>(summary.releaseCount));
+				table.AddCell(summary.totalDownloads);
+				table.AddCell(summary.latestDownloads);
+				if (compare)
+					table.AddCell(deltaDownloadCount, true);
 			}
 
-			std::cout << '\n';
+			if (overflow)
+				std::cerr << "Warning:  Download totals for '" << repoList[i].name << "' exceed the counter range and have been clamped\n";
 		}
 	}
 
+	if (!writer && !table.Write(stdout))
+		std::cerr << "Failed to write the repo table\n";
+
 	if (compare)
-		WriteLastCountData(downloadData);
+	{
+		std::vector<CountDelta::Delta> deltas;
+		CountDelta::Compute(previous, current, deltas);
+		RecordChanges(owner, previous, current, deltas);
+	}
 }
 
 void PrintUsage(const std::string& appName)
 {
-	std::cout << "Usage:  " << appName << " [--compare] [user [repo --all]]" << std::endl;
+	std::cout << "Usage:  " << appName << " [--compare] [--import-counts] [--export=<file>]\n"
+		"          [--format=json|ndjson|csv] [user [repo --all]]\n";
+	std::cout << "        " << appName << " query [user] [--by=repo|release|asset] [--top=<n>]\n"
+		"          [--sort=downloads|growth|first-seen|last-change]\n"
+		"          [--days=<n>] [--until=<time>]" << std::endl;
 	std::cout << "If user and repo names are omitted, user is prompted\n"
 		"to enter the names interactively.  The user name may\n"
 		"be specified without any additional arguments, in which\n"
@@ -454,24 +623,53 @@ void PrintUsage(const std::string& appName)
 		"compares the number of downloads reported with the\n"
 		"number of downloads reported last time the repo was\n"
 		"polled.  Current download count is stored in a local\n"
-		"file." << std::endl;
+		"file for each user (under 'counts'), and counts that\n"
+		"changed are appended to that user's history log, which\n"
+		"is periodically copied into a compressed archive.\n"
+		"Counts saved by earlier versions (in 'lastCounts')\n"
+		"don't record the user, so are only used once imported\n"
+		"with --import-counts for the user they belong to.\n\n"
+		"The --export option additionally writes the\n"
+		"repository, release and asset data to the specified\n"
+		"file as JSON.\n\nThe --format option replaces the printed\n"
+		"tables with one record per release (or per repo, with\n"
+		"--all) as a JSON array, newline-delimited JSON or CSV\n"
+		"(one row per asset for releases).\n\nThe asset counted for each release is\n"
+		"chosen by the rules in the local 'assetRules' file, if\n"
+		"present (one '<priority> <pattern>' per line), or else\n"
+		"is the Windows, macOS or Linux installer.\n\nThe query\n"
+		"command reports on the history recorded by --compare\n"
+		"(for every user, if none is given) without contacting\n"
+		"GitHub.  It lists the top repos, releases or assets\n"
+		"(default 10; 0 for all) by downloads in the window of\n"
+		"the given number of days (default 7) ending now or at\n"
+		"the --until time (a date alone includes that day), by\n"
+		"growth over the window before it, or by when they were\n"
+		"first seen or last changed." << std::endl;
 }
 
 struct CmdLineArgs
 {
 	bool compare = false;
+	bool importCounts = false;// Import the legacy lastCounts file for the user
 	std::string user;
 	std::string repo;
 	bool allRepos = false;
+	std::string exportFileName;
+	bool machineFormat = false;// Otherwise print tables
+	StatsWriter::Format format = StatsWriter::JSON;
 };
 
 bool ProcessArguments(int argc, char *argv[], CmdLineArgs& args)
 {
-	if (argc > 4)
+	if (argc > 7)
 		return false;
 
 	const std::string compareArg("--compare");
+	const std::string importArg("--import-counts");
 	const std::string allArg("--all");
+	const std::string exportArg("--export=");
+	const std::string formatArg("--format=");
 
 	bool expectRepo(false);
 
@@ -483,11 +681,28 @@ bool ProcessArguments(int argc, char *argv[], CmdLineArgs& args)
 			args.compare = true;
 			expectRepo = false;
 		}
+		else if (importArg.compare(argv[i]) == 0)
+		{
+			args.importCounts = true;
+			expectRepo = false;
+		}
 		else if (allArg.compare(argv[i]) == 0)
 		{
 			args.allRepos = true;
 			expectRepo = false;
 		}
+		else if (std::string(argv[i]).compare(0, exportArg.length(), exportArg) == 0)
+		{
+			args.exportFileName = argv[i] + exportArg.length();
+			if (args.exportFileName.empty())
+				return false;
+		}
+		else if (std::string(argv[i]).compare(0, formatArg.length(), formatArg) == 0)
+		{
+			if (!StatsWriter::ParseFormat(argv[i] + formatArg.length(), args.format))
+				return false;
+			args.machineFormat = true;
+		}
 		else if (args.user.empty())
 		{
 			args.user = argv[i];
@@ -508,6 +723,176 @@ bool ProcessArguments(int argc, char *argv[], CmdLineArgs& args)
 	return true;
 }
 
+struct QueryArgs
+{
+	std::string user;// Every user with stored counts, if empty
+	CountRollups::Level level = CountRollups::Repo;
+	CountQuery::SortKey sortKey = CountQuery::Downloads;
+	uint64_t top = 10;// Zero for all
+	uint64_t days = 7;
+	Timestamp until = Timestamp::Now();
+};
+
+bool ParseNumber(const std::string& s, uint64_t& value)
+{
+	const auto result(std::from_chars(s.data(), s.data() + s.length(), value));
+	return result.ec == std::errc() && result.ptr == s.data() + s.length();
+}
+
+bool ProcessQueryArguments(int argc, char *argv[], QueryArgs& args)
+{
+	const std::string byArg("--by=");
+	const std::string sortArg("--sort=");
+	const std::string topArg("--top=");
+	const std::string daysArg("--days=");
+	const std::string untilArg("--until=");
+
+	int i;
+	for (i = 2; i < argc; ++i)
+	{
+		const std::string arg(argv[i]);
+		if (arg.compare(0, byArg.length(), byArg) == 0)
+		{
+			const std::string value(arg.substr(byArg.length()));
+			if (value == "repo")
+				args.level = CountRollups::Repo;
+			else if (value == "release")
+				args.level = CountRollups::Release;
+			else if (value == "asset")
+				args.level = CountRollups::Asset;
+			else
+				return false;
+		}
+		else if (arg.compare(0, sortArg.length(), sortArg) == 0)
+		{
+			const std::string value(arg.substr(sortArg.length()));
+			if (value == "downloads")
+				args.sortKey = CountQuery::Downloads;
+			else if (value == "growth")
+				args.sortKey = CountQuery::Growth;
+			else if (value == "first-seen")
+				args.sortKey = CountQuery::FirstSeen;
+			else if (value == "last-change")
+				args.sortKey = CountQuery::LastChange;
+			else
+				return false;
+		}
+		else if (arg.compare(0, topArg.length(), topArg) == 0)
+		{
+			if (!ParseNumber(arg.substr(topArg.length()), args.top))
+				return false;
+		}
+		else if (arg.compare(0, daysArg.length(), daysArg) == 0)
+		{
+			const uint64_t maxDays(1000000);
+			if (!ParseNumber(arg.substr(daysArg.length()), args.days) || args.days == 0 || args.days > maxDays)
+				return false;
+		}
+		else if (arg.compare(0, untilArg.length(), untilArg) == 0)
+		{
+			// A date alone includes the whole day, since the window ends at
+			// (and includes) the --until time
+			std::string value(arg.substr(untilArg.length()));
+			if (value.length() == 10)
+				value.append("T23:59:59Z");
+			if (!Timestamp::Parse(value, args.until))
+				return false;
+		}
+		else if (args.user.empty() && !arg.empty() && arg[0] != '-')
+			args.user = arg;
+		else
+		{
+			std::cerr << "Unexpected argument:  '" << arg << "'\n";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void PrintQueryResults(const std::vector<CountQuery::Result>& results, const CountRollups::Level& level, const bool& showOwner)
+{
+	// Names align left and numbers right
+	TableRenderer table;
+	table.AddColumn("Repo");
+	if (level != CountRollups::Repo)
+		table.AddColumn("Tag");
+	if (level == CountRollups::Asset)
+		table.AddColumn("Asset");
+	table.AddColumn("Downloads", TableRenderer::Right);
+	table.AddColumn("Previous", TableRenderer::Right);
+	table.AddColumn("Growth", TableRenderer::Right);
+	table.AddColumn("First Seen", TableRenderer::Right);
+	table.AddColumn("Last Change", TableRenderer::Right);
+	table.Reserve(results.size(), 96);
+
+	for (const auto& result : results)
+	{
+		table.AddCell(showOwner ? result.owner.ToString() + "/" + result.repo.ToString() : result.repo.ToString());
+		if (level != CountRollups::Repo)
+			table.AddCell(result.tag.View());
+		if (level == CountRollups::Asset)
+			table.AddCell(result.asset.View());
+
+		table.AddCell(result.downloads);
+		table.AddCell(result.previousDownloads);
+
+		double growth;
+		if (CountQuery::GetGrowth(result, growth))
+		{
+			char text[32];
+			const int length(snprintf(text, sizeof(text), "%+.1f%%", growth * 100.0));
+			table.AddCell(std::string_view(text, std::min<size_t>(std::max(length, 0), sizeof(text) - 1)));
+		}
+		else
+			table.AddCell("-");
+
+		char date[Timestamp::maxLength];
+		table.AddCell(std::string_view(date, Timestamp(result.firstSeen).FormatDate(date)));
+		table.AddCell(std::string_view(date, Timestamp(result.lastChange).FormatDate(date)));
+	}
+
+	if (!table.Write(stdout))
+		std::cerr << "Failed to write the query results\n";
+}
+
+// Reads only local files, so needs no authorization
+int RunQuery(int argc, char *argv[])
+{
+	QueryArgs args;
+	if (!ProcessQueryArguments(argc, argv, args))
+	{
+		PrintUsage(argv[0]);
+		return 1;
+	}
+
+	std::vector<std::string> owners(1, args.user);
+	if (args.user.empty() && !countShards.ReadIndex(owners))
+		return 1;
+
+	CountQuery query;
+	for (const auto& owner : owners)
+	{
+		if (!query.Load(owner, countShards.GetArchiveFileName(owner), countShards.GetHistoryFileName(owner),
+			countShards.GetRollupFileName(owner)))
+		{
+			std::cerr << "Failed to read the download history for '" << owner << "'\n";
+			return 1;
+		}
+	}
+
+	const int64_t end(args.until.GetSeconds());
+	const int64_t begin(end - static_cast<int64_t>(args.days) * 24 * 3600);
+	std::vector<CountQuery::Result> results;
+	query.Run(args.level, begin, end, results);
+	CountQuery::Top(results, args.sortKey, args.top == 0 ? results.size() : static_cast<size_t>(args.top));
+
+	std::cout << "Downloads from " << Timestamp(begin) << " to " << Timestamp(end)
+		<< " (previous:  the " << args.days << " day(s) before)\n\n";
+	PrintQueryResults(results, args.level, owners.size() > 1);
+	return 0;
+}
+
 static const std::string oAuthTokenFileName(".oAuthToken");
 
 bool SetupOAuth2Interface(const std::string& clientId, const std::string& clientSecret, std::ostream& log, std::string& oAuth2Token)
@@ -574,6 +959,9 @@ bool SetupOAuth2Interface(const std::string& clientId, const std::string& client
 
 int main(int argc, char *argv[])
 {
+	if (argc > 1 && std::string(argv[1]) == "query")
+		return RunQuery(argc, argv);
+
 	CmdLineArgs args;
 	if (!ProcessArguments(argc, argv, args))
 	{
@@ -597,8 +985,21 @@ int main(int argc, char *argv[])
 		oAuthFile >> clientSecret;
 	}
 
+	// Optional best-asset rules; the built-in defaults apply if there's no file
+	std::ifstream assetRulesFile(assetRulesFileName.c_str());
+	if (assetRulesFile.is_open())
+	{
+		assetRulesFile.close();
+		if (!AssetClassifier::Get().LoadRules(assetRulesFileName))
+			return 1;
+	}
+
+	if (args.importCounts && !ImportLegacyCounts(args.user))
+		return 1;
+
+	// Keep standard output clean for machine-readable formats
 	std::string token;
-	if (!SetupOAuth2Interface(clientId, clientSecret, std::cout, token))
+	if (!SetupOAuth2Interface(clientId, clientSecret, args.machineFormat ? std::cerr : std::cout, token))
 		return 1;
 
 	GitHubInterface github(userAgent, token);
@@ -606,6 +1007,10 @@ int main(int argc, char *argv[])
 	if (!github.Initialize(args.user))
 		return 1;
 
+	if (args.compare)
+		historyMaintenance = std::async(std::launch::async, &MaintainHistory,
+			countShards.GetHistoryFileName(args.user), countShards.GetArchiveFileName(args.user));
+
 	std::vector<GitHubInterface::RepoInfo> repoList;
 	size_t repo;
 	if (args.repo.empty())
@@ -619,10 +1024,20 @@ int main(int argc, char *argv[])
 			return 1;
 	}
 
+	std::unique_ptr<StatsWriter> writer;
+	if (args.machineFormat)
+		writer = std::make_unique<StatsWriter>(stdout, args.format);
+
 	if (repo < repoList.size())
-		GetStats(github, repoList[repo], args.compare);
+		GetStats(github, repoList[repo], args.user, args.compare, args.exportFileName, writer.get());
 	else
-		GetAllStats(github, repoList, args.compare);
+		GetAllStats(github, repoList, args.user, args.compare, args.exportFileName, writer.get());
+
+	if (writer && !writer->Finish())
+	{
+		std::cerr << "Failed to write output" << std::endl;
+		return 1;
+	}
 
 	return 0;
 }
@@ -0,0 +1,42 @@
+// File:  mappedFile.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Read-only memory mapping of a whole file.
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+// Standard C++ headers
+#include <string>
+#include <cstddef>
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Fails (quietly) if the file doesn't exist; an empty file opens with a
+	// null data pointer
+	bool Open(const std::string& fileName);
+	void Close();
+
+	bool IsOpen() const { return isOpen; }
+	const char* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	const char* data = nullptr;
+	size_t size = 0;
+	bool isOpen = false;
+
+#ifdef _WIN32
+	void* fileHandle = nullptr;
+	void* mappingHandle = nullptr;
+#endif
+};
+
+#endif// MAPPED_FILE_H_
@@ -0,0 +1,74 @@
+// File:  parsePool.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed pool of worker threads for decoding response bodies off of the
+//        thread that performs the transfers.
+
+// Local headers
+#include "parsePool.h"
+
+ParsePool::ParsePool(unsigned int threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+	if (threadCount == 0)
+		threadCount = 1;
+
+	workers.reserve(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i)
+		workers.emplace_back(&ParsePool::WorkerLoop, this);
+}
+
+ParsePool::~ParsePool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskAvailable.notify_all();
+
+	for (auto& worker : workers)
+		worker.join();
+}
+
+void ParsePool::Submit(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push(std::move(task));
+	}
+	taskAvailable.notify_one();
+}
+
+void ParsePool::Wait()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	allDone.wait(lock, [this]() { return tasks.empty() && busyCount == 0; });
+}
+
+void ParsePool::WorkerLoop()
+{
+	while (true)
+	{
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (tasks.empty())
+				return;// Stopping, and nothing left to do
+
+			task = std::move(tasks.front());
+			tasks.pop();
+			++busyCount;
+		}
+
+		task();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			--busyCount;
+			if (tasks.empty() && busyCount == 0)
+				allDone.notify_all();
+		}
+	}
+}
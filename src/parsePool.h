@@ -0,0 +1,113 @@
+// File:  parsePool.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Fixed pool of worker threads for decoding response bodies off of the
+//        thread that performs the transfers.
+
+#ifndef PARSE_POOL_H_
+#define PARSE_POOL_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ParsePool
+{
+public:
+	// Zero selects one thread per hardware thread
+	explicit ParsePool(unsigned int threadCount = 0);
+	~ParsePool();
+
+	ParsePool(const ParsePool&) = delete;
+	ParsePool& operator=(const ParsePool&) = delete;
+
+	typedef std::function<void()> Task;
+	void Submit(Task task);
+
+	// Blocks until every submitted task has completed
+	void Wait();
+
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(workers.size()); }
+
+	// Decodes each body into the corresponding element of results, which is
+	// sized to match bodies; returns true if every body decoded successfully
+	template<typename T>
+	bool Decode(const std::vector<std::string>& bodies,
+		bool (*decode)(const std::string&, std::vector<T>&),
+		std::vector<std::vector<T>>& results);
+
+	// As above, but the results are concatenated in the order of bodies
+	template<typename T>
+	bool Decode(const std::vector<std::string>& bodies,
+		bool (*decode)(const std::string&, std::vector<T>&),
+		std::vector<T>& results);
+
+private:
+	std::vector<std::thread> workers;
+	std::queue<Task> tasks;
+
+	std::mutex mutex;
+	std::condition_variable taskAvailable;
+	std::condition_variable allDone;
+	unsigned int busyCount = 0;
+	bool stopping = false;
+
+	void WorkerLoop();
+};
+
+template<typename T>
+bool ParsePool::Decode(const std::vector<std::string>& bodies,
+	bool (*decode)(const std::string&, std::vector<T>&),
+	std::vector<std::vector<T>>& results)
+{
+	results.clear();
+	results.resize(bodies.size());
+
+	// Each task writes only its own slot, so no locking is required
+	std::vector<char> decoded(bodies.size(), false);
+	for (size_t i = 0; i < bodies.size(); ++i)
+	{
+		Submit([&bodies, decode, &results, &decoded, i]()
+		{
+			decoded[i] = decode(bodies[i], results[i]);
+		});
+	}
+	Wait();
+
+	for (const auto& success : decoded)
+	{
+		if (!success)
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+bool ParsePool::Decode(const std::vector<std::string>& bodies,
+	bool (*decode)(const std::string&, std::vector<T>&),
+	std::vector<T>& results)
+{
+	std::vector<std::vector<T>> pieces;
+	const bool success(Decode(bodies, decode, pieces));
+
+	size_t totalSize(results.size());
+	for (const auto& piece : pieces)
+		totalSize += piece.size();
+	results.reserve(totalSize);
+
+	for (auto& piece : pieces)
+	{
+		for (auto& item : piece)
+			results.push_back(std::move(item));
+	}
+
+	return success;
+}
+
+#endif// PARSE_POOL_H_
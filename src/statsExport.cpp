@@ -0,0 +1,85 @@
+// File:  statsExport.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Machine-readable export of repository, release and asset data.
+
+// Local headers
+#include "statsExport.h"
+#include "jsonWriter.h"
+
+// Standard C++ headers
+#include <iostream>
+#include <cstdio>
+
+void WriteJSON(JSONWriter& writer, const GitHubInterface::AssetData& asset)
+{
+	writer.StartObject();
+	writer.Member("name", asset.name.View());
+	writer.Member("size", asset.fileSize);
+	writer.Member("download_count", asset.downloadCount);
+	writer.EndObject();
+}
+
+void WriteJSON(JSONWriter& writer, const GitHubInterface::ReleaseData& release)
+{
+	writer.StartObject();
+	writer.Member("tag_name", release.tag.View());
+	writer.Member("created_at", release.creationTime.ToString());
+	writer.Key("assets");
+	writer.StartArray();
+	for (const auto& asset : release.assets)
+		WriteJSON(writer, asset);
+	writer.EndArray();
+	writer.EndObject();
+}
+
+void WriteJSON(JSONWriter& writer, const GitHubInterface::RepoInfo& repo,
+	const std::vector<GitHubInterface::ReleaseData>& releases)
+{
+	writer.StartObject();
+	writer.Member("name", repo.name.View());
+	writer.Member("description", repo.description);
+	writer.Member("language", repo.language.View());
+	writer.Member("created_at", repo.creationTime.ToString());
+	writer.Member("updated_at", repo.lastUpdateTime.ToString());
+	writer.Key("releases");
+	writer.StartArray();
+	for (const auto& release : releases)
+		WriteJSON(writer, release);
+	writer.EndArray();
+	writer.EndObject();
+}
+
+bool ExportStats(const std::string& fileName,
+	const std::vector<GitHubInterface::RepoInfo>& repos,
+	const std::vector<std::vector<GitHubInterface::ReleaseData>>& releaseData,
+	const bool& pretty)
+{
+	FILE* file(fopen(fileName.c_str(), "wb"));
+	if (!file)
+	{
+		std::cerr << "Failed to open '" << fileName << "' for output" << std::endl;
+		return false;
+	}
+
+	bool success;
+	{
+		JSONWriter writer(file, pretty);
+		writer.StartArray();
+		for (size_t i = 0; i < repos.size(); ++i)
+		{
+			static const std::vector<GitHubInterface::ReleaseData> noReleases;
+			WriteJSON(writer, repos[i], i < releaseData.size() ? releaseData[i] : noReleases);
+		}
+		writer.EndArray();
+		success = writer.Flush();
+	}
+
+	if (fclose(file) != 0 || !success)
+	{
+		std::cerr << "Failed to write '" << fileName << "'" << std::endl;
+		return false;
+	}
+
+	return true;
+}
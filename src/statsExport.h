@@ -0,0 +1,30 @@
+// File:  statsExport.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Machine-readable export of repository, release and asset data.
+
+#ifndef STATS_EXPORT_H_
+#define STATS_EXPORT_H_
+
+// Standard C++ headers
+#include <string>
+#include <vector>
+
+// Local headers
+#include "gitHubInterface.h"
+
+class JSONWriter;
+
+void WriteJSON(JSONWriter& writer, const GitHubInterface::AssetData& asset);
+void WriteJSON(JSONWriter& writer, const GitHubInterface::ReleaseData& release);
+void WriteJSON(JSONWriter& writer, const GitHubInterface::RepoInfo& repo,
+	const std::vector<GitHubInterface::ReleaseData>& releases);
+
+// Writes an array of repos (each with its releases) to the specified file;
+// releaseData[i] belongs to repos[i]
+bool ExportStats(const std::string& fileName,
+	const std::vector<GitHubInterface::RepoInfo>& repos,
+	const std::vector<std::vector<GitHubInterface::ReleaseData>>& releaseData,
+	const bool& pretty = false);
+
+#endif// STATS_EXPORT_H_
@@ -0,0 +1,211 @@
+// File:  statsWriter.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Machine-readable console output (JSON, NDJSON or CSV) for the stats
+//        that are otherwise printed as tables.  Each record is formatted
+//        directly into one buffer, which is written out whenever it fills
+//        and when the output is finished.
+
+// Local headers
+#include "statsWriter.h"
+
+// Standard C++ headers
+#include <charconv>
+
+bool StatsWriter::ParseFormat(const std::string& name, Format& format)
+{
+	if (name == "json")
+		format = JSON;
+	else if (name == "ndjson")
+		format = NDJSON;
+	else if (name == "csv")
+		format = CSV;
+	else
+		return false;
+
+	return true;
+}
+
+StatsWriter::StatsWriter(FILE* file, const Format& format) : file(file), format(format), json(buffer)
+{
+	buffer.reserve(flushThreshold + 1024);
+	if (format == JSON)
+		json.StartArray();
+}
+
+StatsWriter::~StatsWriter()
+{
+	Finish();
+}
+
+bool StatsWriter::Finish()
+{
+	if (!finished)
+	{
+		finished = true;
+		if (format == JSON)
+		{
+			json.EndArray();
+			buffer.push_back('\n');
+		}
+		Flush();
+		if (fflush(file) != 0)
+			writeFailed = true;
+	}
+
+	return !writeFailed;
+}
+
+void StatsWriter::Flush()
+{
+	if (buffer.empty())
+		return;
+
+	if (fwrite(buffer.data(), 1, buffer.length(), file) != buffer.length())
+		writeFailed = true;
+	buffer.clear();
+}
+
+void StatsWriter::EndRecord()
+{
+	if (format == NDJSON)
+		buffer.push_back('\n');
+
+	if (buffer.length() >= flushThreshold)
+		Flush();
+}
+
+void StatsWriter::CSVHeader(const std::vector<const char*>& columns)
+{
+	if (csvHeaderWritten)
+		return;
+
+	csvHeaderWritten = true;
+	for (size_t i = 0; i < columns.size(); ++i)
+		CSVField(std::string_view(columns[i]), i + 1 == columns.size());
+}
+
+void StatsWriter::CSVField(const std::string_view& value, const bool& last)
+{
+	// RFC 4180:  quote fields containing separators, quotes or line breaks
+	if (value.find_first_of(",\"\r\n") == std::string_view::npos)
+		buffer.append(value);
+	else
+	{
+		buffer.push_back('"');
+		for (const char& c : value)
+		{
+			if (c == '"')
+				buffer.push_back('"');
+			buffer.push_back(c);
+		}
+		buffer.push_back('"');
+	}
+
+	buffer.push_back(last ? '\n' : ',');
+}
+
+void StatsWriter::CSVField(const uint64_t& value, const bool& last)
+{
+	char digits[24];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	buffer.push_back(last ? '\n' : ',');
+}
+
+void StatsWriter::CSVField(const int64_t& value, const bool& last)
+{
+	char digits[24];
+	buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr);
+	buffer.push_back(last ? '\n' : ',');
+}
+
+void StatsWriter::WriteRelease(const InternedString& repo, const GitHubInterface::ReleaseData& release,
+	const std::vector<int64_t>* deltas)
+{
+	char created[Timestamp::maxLength];
+	const std::string_view createdView(created, release.creationTime.Format(created));
+
+	if (format == CSV)
+	{
+		if (deltas)
+			CSVHeader({ "repo", "tag", "created_at", "asset", "size", "download_count", "delta" });
+		else
+			CSVHeader({ "repo", "tag", "created_at", "asset", "size", "download_count" });
+
+		for (size_t i = 0; i < release.assets.size(); ++i)
+		{
+			const GitHubInterface::AssetData& asset(release.assets[i]);
+			CSVField(repo.View());
+			CSVField(release.tag.View());
+			CSVField(createdView);
+			CSVField(asset.name.View());
+			CSVField(asset.fileSize);
+			CSVField(asset.downloadCount, !deltas);
+			if (deltas)
+				CSVField((*deltas)[i], true);
+		}
+
+		EndRecord();
+		return;
+	}
+
+	json.StartObject();
+	json.Member("repo", repo.View());
+	json.Member("tag_name", release.tag.View());
+	json.Member("created_at", createdView);
+	json.Key("assets");
+	json.StartArray();
+	for (size_t i = 0; i < release.assets.size(); ++i)
+	{
+		const GitHubInterface::AssetData& asset(release.assets[i]);
+		json.StartObject();
+		json.Member("name", asset.name.View());
+		json.Member("size", asset.fileSize);
+		json.Member("download_count", asset.downloadCount);
+		if (deltas)
+			json.Member("delta", (*deltas)[i]);
+		json.EndObject();
+	}
+	json.EndArray();
+	json.EndObject();
+	EndRecord();
+}
+
+void StatsWriter::WriteRepo(const GitHubInterface::RepoInfo& repo, const AssetTable::RepoSummary& summary, const int64_t* delta)
+{
+	char updated[Timestamp::maxLength];
+	const std::string_view updatedView(updated, repo.lastUpdateTime.Format(updated));
+	const uint64_t releaseCount(summary.releaseCount);
+
+	if (format == CSV)
+	{
+		if (delta)
+			CSVHeader({ "name", "updated_at", "language", "releases", "total_downloads", "latest_downloads", "delta" });
+		else
+			CSVHeader({ "name", "updated_at", "language", "releases", "total_downloads", "latest_downloads" });
+
+		CSVField(repo.name.View());
+		CSVField(updatedView);
+		CSVField(repo.language.View());
+		CSVField(releaseCount);
+		CSVField(summary.totalDownloads);
+		CSVField(summary.latestDownloads, !delta);
+		if (delta)
+			CSVField(*delta, true);
+
+		EndRecord();
+		return;
+	}
+
+	json.StartObject();
+	json.Member("name", repo.name.View());
+	json.Member("updated_at", updatedView);
+	json.Member("language", repo.language.View());
+	json.Member("releases", releaseCount);
+	json.Member("total_downloads", summary.totalDownloads);
+	json.Member("latest_downloads", summary.latestDownloads);
+	if (delta)
+		json.Member("delta", *delta);
+	json.EndObject();
+	EndRecord();
+}
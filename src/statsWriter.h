@@ -0,0 +1,77 @@
+// File:  statsWriter.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Machine-readable console output (JSON, NDJSON or CSV) for the stats
+//        that are otherwise printed as tables.  Each record is formatted
+//        directly into one buffer, which is written out whenever it fills
+//        and when the output is finished.
+
+#ifndef STATS_WRITER_H_
+#define STATS_WRITER_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+// Local headers
+#include "gitHubInterface.h"
+#include "assetTable.h"
+#include "jsonWriter.h"
+
+class StatsWriter
+{
+public:
+	enum Format
+	{
+		JSON,// One array of records
+		NDJSON,// One record per line
+		CSV// Header line, then one row per record (or per asset for releases)
+	};
+
+	static bool ParseFormat(const std::string& name, Format& format);
+
+	// The file remains owned by the caller
+	StatsWriter(FILE* file, const Format& format);
+	~StatsWriter();
+
+	StatsWriter(const StatsWriter&) = delete;
+	StatsWriter& operator=(const StatsWriter&) = delete;
+
+	// deltas (if not null) holds the change in each asset's count since the
+	// last comparison, in the order of release.assets
+	void WriteRelease(const InternedString& repo, const GitHubInterface::ReleaseData& release,
+		const std::vector<int64_t>* deltas);
+
+	// delta (if not null) is the change in the repo's total downloads
+	void WriteRepo(const GitHubInterface::RepoInfo& repo, const AssetTable::RepoSummary& summary, const int64_t* delta);
+
+	// Closes the JSON array and writes anything buffered; returns false if
+	// any write failed
+	bool Finish();
+
+private:
+	FILE* const file;
+	const Format format;
+	bool finished = false;
+	bool writeFailed = false;
+
+	std::string buffer;
+	JSONWriter json;
+
+	bool csvHeaderWritten = false;
+
+	static const size_t flushThreshold = 64 * 1024;
+
+	void EndRecord();
+	void Flush();
+
+	void CSVHeader(const std::vector<const char*>& columns);
+	void CSVField(const std::string_view& value, const bool& last = false);
+	void CSVField(const uint64_t& value, const bool& last = false);
+	void CSVField(const int64_t& value, const bool& last = false);
+};
+
+#endif// STATS_WRITER_H_
@@ -0,0 +1,123 @@
+// File:  stringInterner.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Process-wide table of unique strings.  Each distinct string is stored
+//        once in an arena and identified by a small integer, so repeated names
+//        cost four bytes apiece and compare as integers.
+
+// Local headers
+#include "stringInterner.h"
+
+// Standard C++ headers
+#include <cstring>
+#include <stdexcept>
+
+StringInterner& StringInterner::Get()
+{
+	static StringInterner interner;
+	return interner;
+}
+
+StringInterner::StringInterner() : segments(new std::unique_ptr<Entry[]>[maxSegments])
+{
+	index.assign(1024, 0);
+
+	// Reserve id 0 for the empty string
+	segments[0].reset(new Entry[segmentSize]);
+	segments[0][0] = Entry{ "", 0, Hash(std::string_view()) };
+	count = 1;
+}
+
+uint32_t StringInterner::Hash(const std::string_view& s)
+{
+	// FNV-1a
+	uint32_t hash(2166136261u);
+	for (const char& c : s)
+		hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+	return hash;
+}
+
+const char* StringInterner::Store(const std::string_view& s)
+{
+	if (s.length() > blockRemaining)
+	{
+		// Oversized strings get a block of their own so the current block isn't wasted
+		const size_t size(std::max(s.length(), blockSize));
+		blocks.emplace_back(new char[size]);
+		if (size > blockSize)
+		{
+			memcpy(blocks.back().get(), s.data(), s.length());
+			return blocks.back().get();
+		}
+		blockPosition = blocks.back().get();
+		blockRemaining = size;
+	}
+
+	char* text(blockPosition);
+	memcpy(text, s.data(), s.length());
+	blockPosition += s.length();
+	blockRemaining -= s.length();
+	return text;
+}
+
+void StringInterner::GrowIndex()
+{
+	std::vector<Id> newIndex(index.size() * 2, 0);
+	const size_t mask(newIndex.size() - 1);
+	for (const auto& id : index)
+	{
+		if (id == 0)
+			continue;
+		size_t slot(GetEntry(id).hash & mask);
+		while (newIndex[slot] != 0)
+			slot = (slot + 1) & mask;
+		newIndex[slot] = id;
+	}
+	index.swap(newIndex);
+}
+
+StringInterner::Id StringInterner::Intern(const std::string_view& s)
+{
+	if (s.empty())
+		return 0;
+
+	const uint32_t hash(Hash(s));
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const size_t mask(index.size() - 1);
+	size_t slot(hash & mask);
+	while (index[slot] != 0)
+	{
+		const Entry& entry(GetEntry(index[slot]));
+		if (entry.hash == hash && entry.length == s.length() && memcmp(entry.text, s.data(), s.length()) == 0)
+			return index[slot];
+		slot = (slot + 1) & mask;
+	}
+
+	if (count == segmentSize * maxSegments)
+		throw std::length_error("StringInterner capacity exceeded");
+
+	const Id id(count);
+	if (id % segmentSize == 0)
+		segments[id / segmentSize].reset(new Entry[segmentSize]);
+	segments[id / segmentSize][id % segmentSize] = Entry{ Store(s), static_cast<uint32_t>(s.length()), hash };
+	++count;
+
+	index[slot] = id;
+	if (count * 2 > index.size())
+		GrowIndex();
+
+	return id;
+}
+
+std::string_view StringInterner::Lookup(const Id& id) const
+{
+	const Entry& entry(GetEntry(id));
+	return std::string_view(entry.text, entry.length);
+}
+
+size_t StringInterner::GetCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return count;
+}
@@ -0,0 +1,113 @@
+// File:  stringInterner.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Process-wide table of unique strings.  Each distinct string is stored
+//        once in an arena and identified by a small integer, so repeated names
+//        cost four bytes apiece and compare as integers.
+
+#ifndef STRING_INTERNER_H_
+#define STRING_INTERNER_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <cstdint>
+#include <functional>
+
+class StringInterner
+{
+public:
+	static StringInterner& Get();
+
+	typedef uint32_t Id;
+
+	// Id 0 is always the empty string
+	Id Intern(const std::string_view& s);
+
+	// Does not lock - ids are only handed out once their text is in place, and
+	// stored text never moves
+	std::string_view Lookup(const Id& id) const;
+
+	size_t GetCount() const;
+
+private:
+	StringInterner();
+	StringInterner(const StringInterner&) = delete;
+	StringInterner& operator=(const StringInterner&) = delete;
+
+	struct Entry
+	{
+		const char* text;
+		uint32_t length;
+		uint32_t hash;
+	};
+
+	mutable std::mutex mutex;
+
+	// Text storage
+	static constexpr size_t blockSize = 64 * 1024;
+	std::vector<std::unique_ptr<char[]>> blocks;
+	char* blockPosition = nullptr;
+	size_t blockRemaining = 0;
+
+	// Entries live in fixed-size segments reached through a directory that is
+	// never reallocated, so lookups are safe while other threads intern
+	static constexpr size_t segmentSize = 4096;
+	static constexpr size_t maxSegments = 16384;
+	std::unique_ptr<std::unique_ptr<Entry[]>[]> segments;
+	Id count = 0;
+
+	// Open-addressed hash index of ids (0 marks an empty slot)
+	std::vector<Id> index;
+
+	const Entry& GetEntry(const Id& id) const { return segments[id / segmentSize][id % segmentSize]; }
+	const char* Store(const std::string_view& s);
+	void GrowIndex();
+
+	static uint32_t Hash(const std::string_view& s);
+};
+
+// Value-type handle to an interned string
+class InternedString
+{
+public:
+	InternedString() = default;
+	explicit InternedString(const std::string_view& s) : id(StringInterner::Get().Intern(s)) {}
+	explicit InternedString(const std::string& s) : InternedString(std::string_view(s)) {}
+	explicit InternedString(const char* s) : InternedString(std::string_view(s)) {}
+
+	StringInterner::Id GetId() const { return id; }
+	std::string_view View() const { return StringInterner::Get().Lookup(id); }
+	std::string ToString() const { return std::string(View()); }
+
+	size_t Length() const { return View().length(); }
+	bool Empty() const { return id == 0; }
+
+	// Identity comparisons - ordering is by first appearance, not alphabetical
+	bool operator==(const InternedString& other) const { return id == other.id; }
+	bool operator!=(const InternedString& other) const { return id != other.id; }
+	bool operator<(const InternedString& other) const { return id < other.id; }
+
+private:
+	StringInterner::Id id = 0;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const InternedString& s)
+{
+	return out << s.View();
+}
+
+namespace std
+{
+template<>
+struct hash<InternedString>
+{
+	size_t operator()(const InternedString& s) const { return s.GetId(); }
+};
+}
+
+#endif// STRING_INTERNER_H_
@@ -0,0 +1,146 @@
+// File:  tableRenderer.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Console table output.  Cells are appended back to back into one
+//        string while the column widths are tracked, then the whole table is
+//        formatted into a buffer sized up front and written with one write().
+
+// Local headers
+#include "tableRenderer.h"
+
+// Standard C++ headers
+#include <algorithm>
+#include <charconv>
+#include <cassert>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+// *nix headers
+#include <unistd.h>
+#include <cerrno>
+#endif// _WIN32
+
+void TableRenderer::AddColumn(const std::string_view& heading, const Alignment& alignment)
+{
+	assert(cellEnds.empty());
+	columns.push_back({ std::string(heading), alignment, heading.length() });
+}
+
+void TableRenderer::AddCell(const std::string_view& text)
+{
+	assert(!columns.empty());
+	cells.append(text);
+	cellEnds.push_back(cells.length());
+
+	size_t& width(columns[(cellEnds.size() - 1) % columns.size()].width);
+	width = std::max(width, text.length());
+}
+
+void TableRenderer::AddCell(const uint64_t& value)
+{
+	char digits[24];
+	AddCell(std::string_view(digits, std::to_chars(digits, digits + sizeof(digits), value).ptr - digits));
+}
+
+void TableRenderer::AddCell(const int64_t& value, const bool& showPlus)
+{
+	char digits[24];
+	char* start(digits);
+	if (showPlus && value > 0)
+		*start++ = '+';
+	AddCell(std::string_view(digits, std::to_chars(start, digits + sizeof(digits), value).ptr - digits));
+}
+
+size_t TableRenderer::GetRowCount() const
+{
+	return columns.empty() ? 0 : cellEnds.size() / columns.size();
+}
+
+void TableRenderer::Reserve(const size_t& rows, const size_t& bytesPerRow)
+{
+	cells.reserve(rows * bytesPerRow);
+	cellEnds.reserve(rows * columns.size());
+}
+
+void TableRenderer::Render(std::string& buffer) const
+{
+	buffer.clear();
+	if (columns.empty())
+		return;
+
+	size_t lineLength(2 * (columns.size() - 1));
+	for (const auto& column : columns)
+		lineLength += column.width;
+
+	// Every line (including the rule) fits in lineLength plus a newline
+	const size_t rowCount(GetRowCount());
+	buffer.reserve((rowCount + 2) * (lineLength + 1));
+
+	const auto appendCell([&buffer](const std::string_view& text, const Column& column, const bool& last)
+	{
+		const size_t padding(column.width - text.length());
+		if (column.alignment == Right)
+			buffer.append(padding, ' ');
+		buffer.append(text);
+		if (column.alignment == Left && !last)
+			buffer.append(padding, ' ');
+	});
+
+	for (size_t i = 0; i < columns.size(); ++i)
+	{
+		if (i > 0)
+			buffer.append(2, ' ');
+		appendCell(columns[i].heading, columns[i], i + 1 == columns.size());
+	}
+	buffer.push_back('\n');
+	buffer.append(lineLength, '-');
+	buffer.push_back('\n');
+
+	size_t begin(0);
+	for (size_t cell = 0; cell < rowCount * columns.size(); ++cell)
+	{
+		const size_t i(cell % columns.size());
+		if (i > 0)
+			buffer.append(2, ' ');
+		appendCell(std::string_view(cells.data() + begin, cellEnds[cell] - begin), columns[i], i + 1 == columns.size());
+		if (i + 1 == columns.size())
+			buffer.push_back('\n');
+		begin = cellEnds[cell];
+	}
+}
+
+bool TableRenderer::Write(FILE* file) const
+{
+	std::string buffer;
+	Render(buffer);
+	return WriteAll(file, buffer);
+}
+
+bool TableRenderer::WriteAll(FILE* file, const std::string_view& data)
+{
+	if (fflush(file) != 0)
+		return false;
+
+	// One call unless the descriptor accepts a partial write
+	const char* next(data.data());
+	size_t size(data.size());
+	while (size > 0)
+	{
+#ifdef _WIN32
+		const int written(_write(_fileno(file), next, static_cast<unsigned int>(std::min<size_t>(size, 1 << 30))));
+		if (written <= 0)
+			return false;
+#else
+		const ssize_t written(write(fileno(file), next, size));
+		if (written < 0 && errno == EINTR)
+			continue;
+		else if (written <= 0)
+			return false;
+#endif// _WIN32
+		next += written;
+		size -= written;
+	}
+
+	return true;
+}
@@ -0,0 +1,63 @@
+// File:  tableRenderer.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  Console table output.  Cells are appended back to back into one
+//        string while the column widths are tracked, then the whole table is
+//        formatted into a buffer sized up front and written with one write().
+
+#ifndef TABLE_RENDERER_H_
+#define TABLE_RENDERER_H_
+
+// Standard C++ headers
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+class TableRenderer
+{
+public:
+	enum Alignment
+	{
+		Left,
+		Right
+	};
+
+	// Columns must all be added before the first cell
+	void AddColumn(const std::string_view& heading, const Alignment& alignment = Left);
+
+	// Cells fill each row from left to right; a row ends after its last column
+	void AddCell(const std::string_view& text);
+	void AddCell(const uint64_t& value);
+	void AddCell(const int64_t& value, const bool& showPlus = false);
+
+	size_t GetRowCount() const;
+	void Reserve(const size_t& rows, const size_t& bytesPerRow);
+
+	// Replaces the contents of buffer with the headings, a dashed rule and the
+	// rows; columns are separated by two spaces and lines carry no trailing
+	// padding
+	void Render(std::string& buffer) const;
+
+	// Flushes anything already buffered in the file, then writes the table to
+	// its descriptor; returns false if the write fails
+	bool Write(FILE* file) const;
+
+	static bool WriteAll(FILE* file, const std::string_view& data);
+
+private:
+	struct Column
+	{
+		std::string heading;
+		Alignment alignment;
+		size_t width;
+	};
+
+	std::vector<Column> columns;
+
+	std::string cells;
+	std::vector<size_t> cellEnds;// Offset in cells just past each cell
+};
+
+#endif// TABLE_RENDERER_H_
@@ -0,0 +1,177 @@
+// File:  timestamp.cpp
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  UTC time stored as seconds since the Unix epoch, with a fixed-format
+//        ISO-8601 parser (the format used throughout the GitHub API).
+
+// Local headers
+#include "timestamp.h"
+
+// Standard C++ headers
+#include <chrono>
+
+Timestamp Timestamp::Now()
+{
+	return Timestamp(std::chrono::duration_cast<std::chrono::seconds>(
+		std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+// Days between 1970-01-01 and the specified (proleptic Gregorian) date.  See
+// Howard Hinnant's "chrono-Compatible Low-Level Date Algorithms".
+static int64_t DaysFromCivil(int64_t y, const unsigned int& m, const unsigned int& d)
+{
+	y -= m <= 2;
+	const int64_t era((y >= 0 ? y : y - 399) / 400);
+	const unsigned int yoe(static_cast<unsigned int>(y - era * 400));
+	const unsigned int doy((153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1);
+	const unsigned int doe(yoe * 365 + yoe / 4 - yoe / 100 + doy);
+	return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+static void CivilFromDays(int64_t z, int64_t& y, unsigned int& m, unsigned int& d)
+{
+	z += 719468;
+	const int64_t era((z >= 0 ? z : z - 146096) / 146097);
+	const unsigned int doe(static_cast<unsigned int>(z - era * 146097));
+	const unsigned int yoe((doe - doe / 1460 + doe / 36524 - doe / 146096) / 365);
+	const unsigned int doy(doe - (365 * yoe + yoe / 4 - yoe / 100));
+	const unsigned int mp((5 * doy + 2) / 153);
+	d = doy - (153 * mp + 2) / 5 + 1;
+	m = mp < 10 ? mp + 3 : mp - 9;
+	y = static_cast<int64_t>(yoe) + era * 400 + (m <= 2);
+}
+
+static bool IsLeapYear(const unsigned int& year)
+{
+	return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+static bool ReadDigits(const char* s, const unsigned int& count, unsigned int& value)
+{
+	value = 0;
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		const unsigned int digit(static_cast<unsigned char>(s[i]) - '0');
+		if (digit > 9)
+			return false;
+		value = value * 10 + digit;
+	}
+	return true;
+}
+
+bool Timestamp::Parse(const char* s, const size_t& length, Timestamp& t)
+{
+	// Fixed positions:  YYYY-MM-DDTHH:MM:SS
+	const size_t baseLength(19);
+	if (length < baseLength || s[4] != '-' || s[7] != '-' ||
+		(s[10] != 'T' && s[10] != 't' && s[10] != ' ') || s[13] != ':' || s[16] != ':')
+		return false;
+
+	unsigned int year, month, day, hour, minute, second;
+	if (!ReadDigits(s, 4, year) || !ReadDigits(s + 5, 2, month) || !ReadDigits(s + 8, 2, day) ||
+		!ReadDigits(s + 11, 2, hour) || !ReadDigits(s + 14, 2, minute) || !ReadDigits(s + 17, 2, second))
+		return false;
+
+	static const unsigned int daysInMonth[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+	if (month < 1 || month > 12 || day < 1 ||
+		day > daysInMonth[month - 1] + (month == 2 && IsLeapYear(year) ? 1 : 0) ||
+		hour > 23 || minute > 59 || second > 60)// Allow leap seconds
+		return false;
+
+	size_t i(baseLength);
+	if (i < length && (s[i] == '.' || s[i] == ','))
+	{
+		++i;
+		const size_t fractionStart(i);
+		while (i < length && s[i] >= '0' && s[i] <= '9')
+			++i;
+		if (i == fractionStart)
+			return false;
+	}
+
+	int64_t offset(0);// [sec]
+	if (i < length)
+	{
+		if (s[i] == 'Z' || s[i] == 'z')
+			++i;
+		else if (s[i] == '+' || s[i] == '-')
+		{
+			unsigned int offsetHour, offsetMinute;
+			if (length - i != 6 || s[i + 3] != ':' ||
+				!ReadDigits(s + i + 1, 2, offsetHour) || !ReadDigits(s + i + 4, 2, offsetMinute) ||
+				offsetHour > 23 || offsetMinute > 59)
+				return false;
+			offset = static_cast<int64_t>(offsetHour * 3600 + offsetMinute * 60);
+			if (s[i] == '-')
+				offset = -offset;
+			i += 6;
+		}
+
+		if (i != length)
+			return false;
+	}
+
+	t = Timestamp(DaysFromCivil(year, month, day) * 86400 + static_cast<int64_t>(hour * 3600 + minute * 60 + second) - offset);
+	return true;
+}
+
+static void WriteDigits(char* buffer, unsigned int value, const unsigned int& count)
+{
+	for (unsigned int i = count; i > 0; --i)
+	{
+		buffer[i - 1] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+}
+
+size_t Timestamp::FormatDate(char* buffer) const
+{
+	if (!IsSet())
+		return 0;
+
+	int64_t days(seconds / 86400);
+	if (seconds % 86400 < 0)
+		--days;
+
+	int64_t year;
+	unsigned int month, day;
+	CivilFromDays(days, year, month, day);
+
+	WriteDigits(buffer, static_cast<unsigned int>(year), 4);
+	buffer[4] = '-';
+	WriteDigits(buffer + 5, month, 2);
+	buffer[7] = '-';
+	WriteDigits(buffer + 8, day, 2);
+	return 10;
+}
+
+size_t Timestamp::Format(char* buffer) const
+{
+	if (FormatDate(buffer) == 0)
+		return 0;
+
+	int64_t secondOfDay(seconds % 86400);
+	if (secondOfDay < 0)
+		secondOfDay += 86400;
+
+	buffer[10] = 'T';
+	WriteDigits(buffer + 11, static_cast<unsigned int>(secondOfDay / 3600), 2);
+	buffer[13] = ':';
+	WriteDigits(buffer + 14, static_cast<unsigned int>(secondOfDay / 60 % 60), 2);
+	buffer[16] = ':';
+	WriteDigits(buffer + 17, static_cast<unsigned int>(secondOfDay % 60), 2);
+	buffer[19] = 'Z';
+	return maxLength;
+}
+
+std::string Timestamp::ToString() const
+{
+	char buffer[maxLength];
+	return std::string(buffer, Format(buffer));
+}
+
+std::string Timestamp::ToDateString() const
+{
+	char buffer[maxLength];
+	return std::string(buffer, FormatDate(buffer));
+}
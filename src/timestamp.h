@@ -0,0 +1,57 @@
+// File:  timestamp.h
+// Date:  10/18/2026
+// Auth:  K. Loux
+// Desc:  UTC time stored as seconds since the Unix epoch, with a fixed-format
+//        ISO-8601 parser (the format used throughout the GitHub API).
+
+#ifndef TIMESTAMP_H_
+#define TIMESTAMP_H_
+
+// Standard C++ headers
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+class Timestamp
+{
+public:
+	Timestamp() = default;
+	explicit Timestamp(const int64_t& seconds) : seconds(seconds), set(true) {}
+
+	static Timestamp Now();
+
+	// Accepts YYYY-MM-DDTHH:MM:SS, optionally followed by fractional seconds
+	// (ignored) and then Z or a +HH:MM/-HH:MM offset.  A missing zone is
+	// taken as UTC.
+	static bool Parse(const char* s, const size_t& length, Timestamp& t);
+	static bool Parse(const std::string& s, Timestamp& t) { return Parse(s.data(), s.length(), t); }
+
+	int64_t GetSeconds() const { return seconds; }
+
+	// False for a default-constructed time (the epoch itself is a valid time)
+	bool IsSet() const { return set; }
+
+	// YYYY-MM-DDTHH:MM:SSZ and YYYY-MM-DD; both are empty if the time isn't set
+	static constexpr size_t maxLength = 20;
+	size_t Format(char* buffer) const;
+	size_t FormatDate(char* buffer) const;
+	std::string ToString() const;
+	std::string ToDateString() const;
+
+	bool operator==(const Timestamp& t) const { return seconds == t.seconds && set == t.set; }
+	bool operator!=(const Timestamp& t) const { return !(*this == t); }
+	bool operator<(const Timestamp& t) const { return seconds < t.seconds; }
+	bool operator>(const Timestamp& t) const { return seconds > t.seconds; }
+
+private:
+	int64_t seconds = 0;
+	bool set = false;
+};
+
+inline std::ostream& operator<<(std::ostream& out, const Timestamp& t)
+{
+	return out << t.ToString();
+}
+
+#endif// TIMESTAMP_H_